@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+// Measures every phase of Compiler::build on generated projects of several
+// sizes and compares the totals against a recorded baseline, when there is
+// one.
+//
+// usage: requite_compile_benchmark [--shape <small|medium|large>]...
+//            [--repetitions <n>] [--optimized] [--output <results.json>]
+//            [--baseline <baseline.json>] [--threshold <fraction>]
+//            [--work-directory <path>]
+
+#include <benchmark_support.hpp>
+#include <project_generator.hpp>
+#include <compiler.hpp>
+#include <build_command.hpp>
+#include <file_io.hpp>
+#include <phase_timer.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/JSON.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr r::ProjectShape SHAPES[] = {
+    {"small", 4UZ, 16UZ, 8UZ, 4UZ, 16UZ},
+    {"medium", 16UZ, 64UZ, 16UZ, 16UZ, 64UZ},
+    {"large", 64UZ, 128UZ, 32UZ, 32UZ, 256UZ}
+};
+
+struct BenchmarkResult final
+{
+    const r::ProjectShape* shape = nullptr;
+    std::string_view optimization{};
+    // the fastest time of each phase over every repetition.
+    llvm::SmallVector<r::PhaseTime> phases{};
+    double total_seconds = 0.0;
+};
+
+const r::ProjectShape& get_shape(std::string_view name)
+{
+    for (const r::ProjectShape& shape : SHAPES)
+    {
+        if (shape.name == name)
+        {
+            return shape;
+        }
+    }
+    throw std::runtime_error(std::format("unknown shape {}.", name));
+}
+
+BenchmarkResult run_benchmark(
+    const r::ProjectShape& shape,
+    const std::filesystem::path& work_directory,
+    std::size_t repetitions,
+    bool is_optimized
+)
+{
+    const std::filesystem::path project_directory = work_directory / shape.name;
+    std::filesystem::remove_all(project_directory);
+    r::BuildCommand build_command;
+    build_command.source_files.push_back(
+        std::filesystem::path(REQUITE_TEST_SOURCES_DIR) / "r_primitives.requite"
+    );
+    for (const std::filesystem::path& path : r::generate_project(shape, project_directory))
+    {
+        build_command.source_files.push_back(path);
+    }
+    build_command.optimization_level =
+        is_optimized ?
+            r::OptimizationLevel::O2 :
+            r::OptimizationLevel::O0;
+    BenchmarkResult result;
+    result.shape = &shape;
+    result.optimization = is_optimized ? "O2" : "O0";
+    for (std::size_t repetition_i = 0UZ; repetition_i < repetitions; repetition_i++)
+    {
+        r::Compiler compiler;
+        compiler.build(build_command);
+        const llvm::SmallVector<r::PhaseTime>& phases = compiler.phase_timer.phases;
+        if (repetition_i == 0UZ)
+        {
+            result.phases = phases;
+            continue;
+        }
+        assert(phases.size() == result.phases.size());
+        for (std::size_t phase_i = 0UZ; phase_i < phases.size(); phase_i++)
+        {
+            result.phases[phase_i].seconds =
+                std::min(
+                    result.phases[phase_i].seconds,
+                    phases[phase_i].seconds
+                );
+        }
+    }
+    for (const r::PhaseTime& phase : result.phases)
+    {
+        result.total_seconds += phase.seconds;
+    }
+    return result;
+}
+
+void write_result(llvm::json::OStream& json, const BenchmarkResult& result)
+{
+    json.attribute("shape", llvm::StringRef(result.shape->name));
+    json.attribute("optimization", llvm::StringRef(result.optimization));
+    json.attribute("modules", static_cast<std::int64_t>(result.shape->module_count));
+    json.attribute("procedures", static_cast<std::int64_t>(result.shape->module_count * result.shape->procedure_count));
+    json.attributeObject(
+        "phases",
+        [&]()
+        {
+            for (const r::PhaseTime& phase : result.phases)
+            {
+                json.attribute(llvm::StringRef(phase.name), phase.seconds);
+            }
+        }
+    );
+    json.attribute("total", result.total_seconds);
+}
+
+// returns true if any total is slower than the baseline by more than threshold.
+bool compare_to_baseline(
+    const std::filesystem::path& baseline_path,
+    const llvm::SmallVector<BenchmarkResult>& results,
+    double threshold
+)
+{
+    const std::string baseline_text = r::read_file_text(baseline_path);
+    llvm::Expected<llvm::json::Value> expected_baseline = llvm::json::parse(baseline_text);
+    if (!expected_baseline)
+    {
+        throw std::runtime_error(llvm::toString(expected_baseline.takeError()));
+    }
+    const llvm::json::Object* baseline_object = expected_baseline->getAsObject();
+    const llvm::json::Array* baseline_results =
+        baseline_object == nullptr ?
+            nullptr :
+            baseline_object->getArray("results");
+    if (baseline_results == nullptr)
+    {
+        throw std::runtime_error("baseline has no results array.");
+    }
+    bool has_regression = false;
+    for (const BenchmarkResult& result : results)
+    {
+        std::optional<double> baseline_total{};
+        for (const llvm::json::Value& baseline_result_value : *baseline_results)
+        {
+            const llvm::json::Object* baseline_result = baseline_result_value.getAsObject();
+            if (
+                baseline_result != nullptr &&
+                baseline_result->getString("shape") == llvm::StringRef(result.shape->name) &&
+                baseline_result->getString("optimization") == llvm::StringRef(result.optimization)
+            )
+            {
+                baseline_total = baseline_result->getNumber("total");
+                break;
+            }
+        }
+        if (!baseline_total.has_value() || *baseline_total <= 0.0)
+        {
+            std::cout << std::format("{} {}: no baseline\n", result.shape->name, result.optimization);
+            continue;
+        }
+        const double ratio = result.total_seconds / *baseline_total;
+        const bool is_regression = ratio > 1.0 + threshold;
+        has_regression = has_regression || is_regression;
+        std::cout << std::format(
+            "{} {}: {:.4f}s vs {:.4f}s baseline ({:+.1f}%){}\n",
+            result.shape->name,
+            result.optimization,
+            result.total_seconds,
+            *baseline_total,
+            (ratio - 1.0) * 100.0,
+            is_regression ? " REGRESSION" : ""
+        );
+    }
+    return has_regression;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        llvm::SmallVector<const r::ProjectShape*> shapes{};
+        bool is_optimized = false;
+        std::filesystem::path baseline_path{};
+        double threshold = 0.10;
+        const r::BenchmarkOptions options =
+            r::parse_benchmark_arguments(
+                argc,
+                argv,
+                "compile_benchmark",
+                5UZ,
+                [&](std::string_view option, llvm::function_ref<std::string_view()> take_value)
+                {
+                    if (option == "--optimized")
+                    {
+                        is_optimized = true;
+                    }
+                    else if (option == "--shape")
+                    {
+                        shapes.push_back(&get_shape(take_value()));
+                    }
+                    else if (option == "--baseline")
+                    {
+                        baseline_path = take_value();
+                    }
+                    else if (option == "--threshold")
+                    {
+                        threshold = std::stod(std::string(take_value()));
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    return true;
+                }
+            );
+        if (shapes.empty())
+        {
+            for (const r::ProjectShape& shape : SHAPES)
+            {
+                shapes.push_back(&shape);
+            }
+        }
+        llvm::SmallVector<BenchmarkResult> results{};
+        for (const r::ProjectShape* shape : shapes)
+        {
+            const BenchmarkResult& result =
+                results.emplace_back(
+                    run_benchmark(
+                        *shape,
+                        options.work_directory,
+                        options.repetitions,
+                        is_optimized
+                    )
+                );
+            std::cout << std::format("{} {}: {:.4f}s\n", shape->name, result.optimization, result.total_seconds);
+            for (const r::PhaseTime& phase : result.phases)
+            {
+                std::cout << std::format("  {:<28} {:.4f}s\n", phase.name, phase.seconds);
+            }
+        }
+        r::write_benchmark_results(
+            options.output_path,
+            results.size(),
+            [&](llvm::json::OStream& json, std::size_t result_i)
+            {
+                write_result(json, results[result_i]);
+            }
+        );
+        if (baseline_path.empty())
+        {
+            return EXIT_SUCCESS;
+        }
+        if (!std::filesystem::exists(baseline_path))
+        { // no baseline has been recorded for this checkout.
+            std::cout << std::format("no baseline at {}, comparison skipped.\n", baseline_path.string());
+            return EXIT_SUCCESS;
+        }
+        if (compare_to_baseline(baseline_path, results, threshold))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <project_generator.hpp>
+#include <file_io.hpp>
+
+#include <cassert>
+#include <format>
+#include <iterator>
+#include <string>
+
+namespace r {
+
+namespace {
+
+// a right nested chain of arithmetic, such as [+ a [- b [* a 1]]].
+void append_expression(std::string& text, std::size_t depth)
+{
+    constexpr std::string_view OPERATORS[] = {"+", "-", "*"};
+    for (std::size_t depth_i = 0UZ; depth_i < depth; depth_i++)
+    {
+        std::format_to(
+            std::back_inserter(text),
+            "[{} {} ",
+            OPERATORS[depth_i % std::size(OPERATORS)],
+            depth_i % 2UZ == 0UZ ? "a" : "b"
+        );
+    }
+    text += "1";
+    text.append(depth, ']');
+}
+
+std::string generate_module(const r::ProjectShape& shape, std::size_t module_i)
+{
+    std::string text{};
+    auto out = std::back_inserter(text);
+    std::format_to(out, "[module bench_{}]\n\n", module_i);
+    if (module_i != 0UZ)
+    {
+        std::format_to(out, "[import bench_{}]\n\n", module_i - 1UZ);
+    }
+    for (std::size_t object_i = 0UZ; object_i < shape.object_count; object_i++)
+    {
+        std::format_to(
+            out,
+            "[object Counter{}\n"
+            "    [property value r:i32 0]\n"
+            "\n"
+            "    [constructor [arguments r:i32 value]\n"
+            "        [= [this].value value]\n"
+            "    ]\n"
+            "\n"
+            "    [destructor\n"
+            "        [= [this].value 0]\n"
+            "    ]\n"
+            "\n"
+            "    [method get r:i32\n"
+            "        [return [this].value]\n"
+            "    ]\n"
+            "]\n\n",
+            object_i
+        );
+    }
+    std::format_to(out, "[export_group b{}\n", module_i);
+    for (std::size_t procedure_i = 0UZ; procedure_i < shape.procedure_count; procedure_i++)
+    {
+        std::format_to(
+            out,
+            "\n    [function p{} r:i32 [arguments r:i32 a r:i32 b]\n"
+            "        [local c r:i32 ",
+            procedure_i
+        );
+        r::append_expression(text, shape.expression_depth);
+        text += "]\n";
+        if (module_i == 0UZ)
+        {
+            text += "        [return c]\n";
+        }
+        else
+        {
+            std::format_to(
+                out,
+                "        [return [+ c b{}:p{}(a b)]]\n",
+                module_i - 1UZ,
+                procedure_i
+            );
+        }
+        text += "    ]\n";
+    }
+    text += "\n    [function use_objects r:i32 [arguments r:i32 a]\n";
+    for (std::size_t object_i = 0UZ; object_i < shape.object_count; object_i++)
+    {
+        std::format_to(out, "        [local o{} Counter{}{{a}}]\n", object_i, object_i);
+    }
+    text += "        [local total r:i32 0]\n";
+    for (std::size_t object_i = 0UZ; object_i < shape.object_count; object_i++)
+    {
+        std::format_to(out, "        [+= total o{}.get()]\n", object_i);
+    }
+    text += "        [return total]\n    ]\n";
+    text += "\n    [function dispatch r:i32 [arguments r:i32 a]\n        [switch a\n";
+    for (std::size_t case_i = 0UZ; case_i < shape.switch_case_count; case_i++)
+    {
+        std::format_to(
+            out,
+            "            [case {}\n"
+            "                [return b{}:p{}(a {})]\n"
+            "            ]\n",
+            case_i,
+            module_i,
+            case_i % shape.procedure_count,
+            case_i
+        );
+    }
+    std::format_to(
+        out,
+        "            [default\n"
+        "                [return b{}:use_objects(a)]\n"
+        "            ]\n"
+        "        ]\n"
+        "        [return 0]\n"
+        "    ]\n"
+        "]\n",
+        module_i
+    );
+    if (module_i + 1UZ == shape.module_count)
+    {
+        std::format_to(
+            out,
+            "\n[entry_point\n"
+            "    [local total r:i32 0]\n"
+            "    [for [local i r:i32 0][< i {}][+= i 1]\n"
+            "        [+= total b{}:dispatch(i)]\n"
+            "    ]\n"
+            "]\n",
+            shape.switch_case_count + 1UZ,
+            module_i
+        );
+    }
+    return text;
+}
+
+}
+
+llvm::SmallVector<std::filesystem::path> generate_project(const r::ProjectShape& shape, const std::filesystem::path& directory)
+{
+    assert(shape.module_count != 0UZ);
+    assert(shape.procedure_count != 0UZ);
+    std::filesystem::create_directories(directory);
+    llvm::SmallVector<std::filesystem::path> paths{};
+    paths.reserve(shape.module_count);
+    for (std::size_t module_i = 0UZ; module_i < shape.module_count; module_i++)
+    {
+        std::filesystem::path& path =
+            paths.emplace_back(
+                directory / std::format("bench_{}.requite", module_i)
+            );
+        r::write_file_text(path, r::generate_module(shape, module_i));
+    }
+    return paths;
+}
+
+}
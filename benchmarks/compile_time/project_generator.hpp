@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace r {
+
+// The size of a synthetic requite project. Every count is per module.
+struct ProjectShape final
+{
+    std::string_view name{};
+    std::size_t module_count = 1UZ;
+    std::size_t procedure_count = 1UZ;
+    std::size_t expression_depth = 1UZ;
+    std::size_t object_count = 0UZ;
+    std::size_t switch_case_count = 0UZ;
+};
+
+// Writes one source file per module into directory and returns their paths.
+// Each module imports the one before it and calls into its export group, and
+// the last module contains the entry point, so every procedure is reachable.
+llvm::SmallVector<std::filesystem::path> generate_project(const r::ProjectShape& shape, const std::filesystem::path& directory);
+
+}
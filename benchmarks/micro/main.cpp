@@ -0,0 +1,426 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+// Times the resolver type operations and symbol table lookups in isolation on
+// synthetic populations, so that changes to their data structures can be
+// measured without the noise of a whole build.
+//
+// usage: requite_micro_benchmark [--benchmark <name>]... [--repetitions <n>]
+//            [--output <results.json>] [--work-directory <path>]
+
+#include <benchmark_support.hpp>
+#include <binary.hpp>
+#include <module/module.hpp>
+#include <cataloger/cataloger.hpp>
+#include <resolver/resolver.hpp>
+#include <symbol_table.hpp>
+#include <object.hpp>
+#include <export_group.hpp>
+#include <procedure_group.hpp>
+#include <procedure.hpp>
+#include <type.hpp>
+#include <operation.hpp>
+#include <literal.hpp>
+#include <llvm_extensions.hpp>
+#include <file_io.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/StringSaver.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+// objects declared in the generated module. each is the root of one deep type.
+constexpr std::size_t OBJECT_COUNT = 512UZ;
+// overloads of the one wide procedure group.
+constexpr std::size_t OVERLOAD_COUNT = 256UZ;
+// alternating pointer and array subtypes on every deep type.
+constexpr std::size_t SUBTYPE_DEPTH = 16UZ;
+// nesting of the literal arithmetic passed to deduce_type.
+constexpr std::size_t EXPRESSION_DEPTH = 32UZ;
+// symbols in the standalone table.
+constexpr std::size_t TABLE_SIZE = 65536UZ;
+
+struct Microbenchmark final
+{
+    std::string_view name{};
+    // runs one pass over the population and returns the operations performed.
+    std::function<std::size_t()> run{};
+};
+
+struct MicrobenchmarkResult final
+{
+    std::string_view name{};
+    std::size_t operations = 0UZ;
+    llvm::SmallVector<double> nanoseconds_per_operation{};
+};
+
+// keeps results observable so that the measured calls are not optimized out.
+volatile std::size_t sink = 0UZ;
+
+std::string generate_source()
+{
+    std::string text{};
+    auto out = std::back_inserter(text);
+    text += "[module micro]\n\n";
+    for (std::size_t object_i = 0UZ; object_i < OBJECT_COUNT; object_i++)
+    {
+        std::format_to(
+            out,
+            "[object O{}\n"
+            "    [property value r:i32 0]\n"
+            "]\n\n",
+            object_i
+        );
+    }
+    text += "[export_group m\n";
+    for (std::size_t overload_i = 0UZ; overload_i < OVERLOAD_COUNT; overload_i++)
+    {
+        // every overload takes a distinct object, so any argument list
+        // matches exactly one of them after checking the whole group.
+        std::format_to(
+            out,
+            "\n    [function pick r:i32 [arguments {}[builtin_array O{} 4] a]\n"
+            "        [return 0]\n"
+            "    ]\n",
+            std::string(overload_i % 3UZ + 1UZ, '*'),
+            overload_i % OBJECT_COUNT
+        );
+    }
+    text += "]\n";
+    return text;
+}
+
+// runs the frontend up to the point where types can be resolved.
+void catalog(r::Binary& binary, const std::filesystem::path& work_directory)
+{
+    const std::filesystem::path source_path = work_directory / "micro.requite";
+    std::filesystem::create_directories(work_directory);
+    r::write_file_text(source_path, generate_source());
+    r::initialize_llvm();
+    binary.initialize_llvm_context();
+    const std::filesystem::path source_paths[] = {
+        std::filesystem::path(REQUITE_TEST_SOURCES_DIR) / "r_primitives.requite",
+        source_path
+    };
+    binary.modules.reserve(std::size(source_paths));
+    for (const std::filesystem::path& path : source_paths)
+    {
+        r::Module& module = binary.add_module();
+        module.read_source(path);
+        module.parse_ast();
+        module.determine_name();
+    }
+    binary.map_modules();
+    for (r::Module& module : binary.modules)
+    {
+        module.determine_imports();
+    }
+    for (r::Module& module : binary.modules)
+    {
+        module.expand_imports();
+    }
+    binary.check_no_circular_imports();
+    binary.determine_module_order();
+    r::Cataloger cataloger;
+    for (r::Module& module : binary.modules)
+    {
+        cataloger.tabulate(module);
+    }
+    for (r::Module& module : binary.modules)
+    {
+        cataloger.tabulate_extensions(module);
+    }
+    for (r::Module& module : binary.modules)
+    {
+        module.index_visible_symbols();
+    }
+    for (r::Module& module : binary.modules)
+    {
+        cataloger.catalog(module);
+    }
+    for (r::Module& module : binary.modules)
+    {
+        module.resolve_type_aliases();
+    }
+}
+
+// wraps root in depth subtypes, alternating pointers and arrays.
+// (ex: *[builtin_array *[builtin_array O0 4] 4])
+r::Expression make_type_expression(std::string_view root, std::size_t depth)
+{
+    r::Expression expression = root;
+    for (std::size_t depth_i = 0UZ; depth_i < depth; depth_i++)
+    {
+        r::Operation operation;
+        if (depth_i % 2UZ == 0UZ)
+        {
+            operation.opcode = r::Opcode::BUILTIN_ARRAY;
+            operation.branches.push_back(std::move(expression));
+            operation.branches.push_back(r::Literal{"4", r::LiteralType::NUMBER});
+        }
+        else
+        {
+            operation.opcode = r::Opcode::STAR;
+            operation.branches.push_back(std::move(expression));
+        }
+        expression = std::move(operation);
+    }
+    return expression;
+}
+
+// a right nested chain of literal arithmetic, such as [+ 1 [* 2 [+ 3 4]]].
+r::Expression make_arithmetic_expression(std::size_t depth)
+{
+    constexpr std::string_view NUMBERS[] = {"1", "2", "3", "4"};
+    r::Expression expression = r::Literal{NUMBERS[0], r::LiteralType::NUMBER};
+    for (std::size_t depth_i = 0UZ; depth_i < depth; depth_i++)
+    {
+        r::Operation operation;
+        operation.opcode = depth_i % 2UZ == 0UZ ? r::Opcode::PLUS : r::Opcode::STAR;
+        operation.branches.push_back(r::Literal{NUMBERS[depth_i % std::size(NUMBERS)], r::LiteralType::NUMBER});
+        operation.branches.push_back(std::move(expression));
+        expression = std::move(operation);
+    }
+    return expression;
+}
+
+void write_result(llvm::json::OStream& json, const MicrobenchmarkResult& result)
+{
+    json.attribute("name", llvm::StringRef(result.name));
+    json.attribute("operations", static_cast<std::int64_t>(result.operations));
+    r::write_benchmark_samples(
+        json,
+        "nanoseconds_per_operation",
+        "median_nanoseconds_per_operation",
+        result.nanoseconds_per_operation
+    );
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        llvm::SmallVector<std::string_view> selected_names{};
+        const r::BenchmarkOptions options =
+            r::parse_benchmark_arguments(
+                argc,
+                argv,
+                "micro_benchmark",
+                10UZ,
+                [&](std::string_view option, llvm::function_ref<std::string_view()> take_value)
+                {
+                    if (option != "--benchmark")
+                    {
+                        return false;
+                    }
+                    selected_names.push_back(take_value());
+                    return true;
+                }
+            );
+
+        r::Binary binary;
+        catalog(binary, options.work_directory);
+        r::Module& module = binary.modules.back();
+        r::Resolver resolver;
+        resolver.enter(module);
+
+        llvm::SmallVector<r::Expression> type_expressions{};
+        for (const std::unique_ptr<r::Object>& object : module.objects)
+        {
+            type_expressions.push_back(make_type_expression(object->name, SUBTYPE_DEPTH));
+        }
+        llvm::SmallVector<r::Type> types{};
+        for (const r::Expression& type_expression : type_expressions)
+        {
+            types.push_back(resolver.resolve_type(type_expression));
+        }
+        llvm::SmallVector<r::Expression> deduced_expressions{};
+        for (std::size_t depth = 1UZ; depth <= EXPRESSION_DEPTH; depth++)
+        {
+            deduced_expressions.push_back(make_arithmetic_expression(depth));
+        }
+        for (const r::Expression& type_expression : type_expressions)
+        {
+            r::Operation local_operation;
+            local_operation.opcode = r::Opcode::LOCAL;
+            local_operation.branches.push_back(std::string_view("x"));
+            local_operation.branches.push_back(type_expression);
+            local_operation.branches.push_back(r::Operation{r::Opcode::INDETERMINATE_VALUE});
+            deduced_expressions.push_back(std::move(local_operation));
+        }
+
+        r::ExportGroup* export_group = binary.table.try_get_export_group("m");
+        assert(export_group != nullptr);
+        r::ProcedureGroup* pick_group = export_group->table.try_get_procedure_group("pick");
+        assert(pick_group != nullptr);
+        llvm::SmallVector<r::Type> overload_arguments{};
+        for (const r::Procedure* overload : pick_group->overloads)
+        {
+            assert(overload->arguments.size() == 1UZ);
+            overload_arguments.push_back(overload->arguments.front().type);
+        }
+
+        // the standalone table is larger than any real scope, so its lookups
+        // are dominated by the table itself rather than the resolver.
+        llvm::BumpPtrAllocator allocator;
+        llvm::StringSaver string_saver(allocator);
+        llvm::SmallVector<std::unique_ptr<r::Object>> table_objects{};
+        llvm::SmallVector<std::string_view> table_names{};
+        r::SymbolTable table;
+        for (std::size_t symbol_i = 0UZ; symbol_i < TABLE_SIZE; symbol_i++)
+        {
+            r::Object& object = *table_objects.emplace_back(std::make_unique<r::Object>());
+            object.name = string_saver.save(std::format("symbol_{}", symbol_i));
+            table.add_to_table(object);
+            table_names.push_back(object.name);
+            // every other lookup misses, like a name searched in an outer scope.
+            table_names.push_back(string_saver.save(std::format("missing_{}", symbol_i)));
+        }
+
+        const Microbenchmark benchmarks[] = {
+            {
+                "resolve_type",
+                [&]()
+                {
+                    for (const r::Expression& type_expression : type_expressions)
+                    {
+                        sink = sink + resolver.resolve_type(type_expression).subtypes.size();
+                    }
+                    return type_expressions.size();
+                }
+            },
+            {
+                "deduce_type",
+                [&]()
+                {
+                    for (const r::Expression& expression : deduced_expressions)
+                    {
+                        sink = sink + resolver.deduce_type(expression).subtypes.size();
+                    }
+                    return deduced_expressions.size();
+                }
+            },
+            {
+                "get_types_are_equivalent",
+                [&]()
+                {
+                    std::size_t operations = 0UZ;
+                    for (std::size_t type_i = 0UZ; type_i < types.size(); type_i++)
+                    {
+                        // one equal pair and one pair that differs only at the root.
+                        sink = sink + r::get_types_are_equivalent(types[type_i], types[type_i]);
+                        sink = sink + r::get_types_are_equivalent(types[type_i], types[(type_i + 1UZ) % types.size()]);
+                        operations += 2UZ;
+                    }
+                    return operations;
+                }
+            },
+            {
+                "get_is_type_assignable_to_type",
+                [&]()
+                {
+                    std::size_t operations = 0UZ;
+                    for (std::size_t type_i = 0UZ; type_i < types.size(); type_i++)
+                    {
+                        sink = sink + resolver.get_is_type_assignable_to_type(types[type_i], types[type_i]);
+                        sink = sink + resolver.get_is_type_assignable_to_type(types[type_i], types[(type_i + 1UZ) % types.size()]);
+                        operations += 2UZ;
+                    }
+                    return operations;
+                }
+            },
+            {
+                "get_best_overload",
+                [&]()
+                {
+                    for (const r::Type& argument : overload_arguments)
+                    {
+                        r::Procedure& procedure = resolver.get_best_overload(*pick_group, std::span<const r::Type>(&argument, 1UZ));
+                        sink = sink + procedure.arguments.size();
+                    }
+                    return overload_arguments.size();
+                }
+            },
+            {
+                "SymbolTable::try_get_symbol",
+                [&]()
+                {
+                    for (std::string_view name : table_names)
+                    {
+                        sink = sink + (table.try_get_symbol(name) != nullptr);
+                    }
+                    return table_names.size();
+                }
+            }
+        };
+
+        llvm::SmallVector<MicrobenchmarkResult> results{};
+        for (const Microbenchmark& benchmark : benchmarks)
+        {
+            if (
+                !selected_names.empty() &&
+                std::ranges::find(selected_names, benchmark.name) == selected_names.end()
+            )
+            {
+                continue;
+            }
+            MicrobenchmarkResult& result = results.emplace_back();
+            result.name = benchmark.name;
+            // the first pass warms the caches and is not recorded.
+            result.operations = benchmark.run();
+            for (std::size_t repetition_i = 0UZ; repetition_i < options.repetitions; repetition_i++)
+            {
+                const auto start_time = std::chrono::steady_clock::now();
+                const std::size_t operations = benchmark.run();
+                const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start_time;
+                result.nanoseconds_per_operation.push_back(duration.count() / static_cast<double>(operations));
+            }
+            std::cout << std::format(
+                "{:<32} {:>10.1f} ns/op ({} ops per pass)\n",
+                result.name,
+                r::get_median(result.nanoseconds_per_operation),
+                result.operations
+            );
+        }
+        if (results.empty())
+        {
+            throw std::runtime_error("no benchmark matched the given names.");
+        }
+        r::write_benchmark_results(
+            options.output_path,
+            results.size(),
+            [&](llvm::json::OStream& json, std::size_t result_i)
+            {
+                write_result(json, results[result_i]);
+            }
+        );
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
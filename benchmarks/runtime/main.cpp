@@ -0,0 +1,345 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+// Compiles each program in benchmark_sources at every optimization level,
+// runs it several times and records its wall time, and its instruction count
+// when perf is available. The output of every level is checked against O0 so
+// that miscompiles are not reported as speedups.
+//
+// usage: requite_runtime_benchmark [--program <name>]... [--repetitions <n>]
+//            [--output <results.json>] [--work-directory <path>]
+
+#include <benchmark_support.hpp>
+#include <compiler.hpp>
+#include <build_command.hpp>
+#include <file_io.hpp>
+#include <optimization_level.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/Program.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr std::string_view PROGRAMS[] = {
+    "matrix_multiply",
+    "n_body",
+    "objects",
+    "sieve",
+    "sort",
+    "strings"
+};
+
+// the sources every program is built with.
+constexpr std::string_view LIBRARY_SOURCES[] = {
+    "r_primitives.requite",
+    "libc_stdio.requite",
+    "libc_math.requite"
+};
+
+struct OptimizationLevelName final
+{
+    r::OptimizationLevel optimization_level = r::OptimizationLevel::O0;
+    std::string_view name{};
+};
+
+constexpr OptimizationLevelName OPTIMIZATION_LEVELS[] = {
+    {r::OptimizationLevel::O0, "O0"},
+    {r::OptimizationLevel::O1, "O1"},
+    {r::OptimizationLevel::O2, "O2"},
+    {r::OptimizationLevel::O3, "O3"},
+    {r::OptimizationLevel::OS, "Os"},
+    {r::OptimizationLevel::OZ, "Oz"}
+};
+
+struct BenchmarkResult final
+{
+    std::string_view program{};
+    std::string_view optimization{};
+    double compile_seconds = 0.0;
+    llvm::SmallVector<double> run_seconds{};
+    std::optional<std::uint64_t> instructions{};
+    bool has_matching_output = true;
+};
+
+// runs the program with its output redirected and returns its wall time.
+double run_program(
+    const std::filesystem::path& program_path,
+    const llvm::SmallVector<llvm::StringRef>& arguments,
+    const std::filesystem::path& output_path
+)
+{
+    const std::string output_path_string = output_path.string();
+    const std::optional<llvm::StringRef> redirects[] = {
+        llvm::StringRef(""),
+        llvm::StringRef(output_path_string),
+        llvm::StringRef(output_path_string)
+    };
+    std::string error{};
+    const auto start_time = std::chrono::steady_clock::now();
+    const int result =
+        llvm::sys::ExecuteAndWait(
+            arguments.front(),
+            arguments,
+            std::nullopt,
+            redirects,
+            0U,
+            0U,
+            &error
+        );
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_time;
+    if (result != 0)
+    {
+        throw std::runtime_error(
+            std::format(
+                "{} failed with {}. {}",
+                program_path.string(),
+                result,
+                error
+            )
+        );
+    }
+    return duration.count();
+}
+
+std::optional<std::uint64_t> count_instructions(
+    const std::string& perf_path,
+    const std::filesystem::path& program_path,
+    const std::filesystem::path& directory
+)
+{
+    const std::filesystem::path stat_path = directory / "perf_stat.csv";
+    const std::string stat_path_string = stat_path.string();
+    const std::string program_path_string = program_path.string();
+    const llvm::SmallVector<llvm::StringRef> arguments = {
+        perf_path,
+        "stat",
+        "-x",
+        ",",
+        "-e",
+        "instructions:u",
+        "-o",
+        stat_path_string,
+        "--",
+        program_path_string
+    };
+    run_program(program_path, arguments, directory / "perf_output.txt");
+    // csv lines are <count>,<unit>,<event>,...
+    llvm::SmallVector<llvm::StringRef> lines{};
+    const std::string stat_text = r::read_file_text(stat_path);
+    llvm::StringRef(stat_text).split(lines, '\n');
+    for (llvm::StringRef line : lines)
+    {
+        if (!line.contains("instructions"))
+        {
+            continue;
+        }
+        std::uint64_t instructions = 0UZ;
+        if (!line.split(',').first.trim().getAsInteger(10, instructions))
+        {
+            return instructions;
+        }
+    }
+    return std::nullopt;
+}
+
+BenchmarkResult run_benchmark(
+    std::string_view program,
+    const OptimizationLevelName& optimization_level,
+    std::size_t repetitions,
+    const std::filesystem::path& work_directory,
+    const std::optional<std::string>& perf_path
+)
+{
+    // the compiler writes objects next to the sources, so they are copied
+    // out of the source tree first.
+    const std::filesystem::path directory = work_directory / program / optimization_level.name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    r::BuildCommand build_command;
+    for (std::string_view library_source : LIBRARY_SOURCES)
+    {
+        const std::filesystem::path& source_path =
+            build_command.source_files.emplace_back(directory / library_source);
+        std::filesystem::copy_file(
+            std::filesystem::path(REQUITE_TEST_SOURCES_DIR) / library_source,
+            source_path
+        );
+    }
+    const std::filesystem::path& program_source_path =
+        build_command.source_files.emplace_back(
+            directory / std::format("{}.requite", program)
+        );
+    std::filesystem::copy_file(
+        std::filesystem::path(REQUITE_BENCHMARK_SOURCES_DIR) / program_source_path.filename(),
+        program_source_path
+    );
+    build_command.optimization_level = optimization_level.optimization_level;
+    build_command.link_output = r::LinkOutput::EXECUTABLE;
+    build_command.output_path = directory / program;
+
+    BenchmarkResult result;
+    result.program = program;
+    result.optimization = optimization_level.name;
+    r::Compiler compiler;
+    if (compiler.build(build_command) != 0)
+    {
+        throw std::runtime_error(std::format("failed to build {} at {}.", program, optimization_level.name));
+    }
+    result.compile_seconds = compiler.phase_timer.get_total_seconds();
+
+    const std::string program_path_string = build_command.output_path.string();
+    const llvm::SmallVector<llvm::StringRef> arguments = {program_path_string};
+    for (std::size_t repetition_i = 0UZ; repetition_i < repetitions; repetition_i++)
+    {
+        result.run_seconds.push_back(
+            run_program(
+                build_command.output_path,
+                arguments,
+                directory / "output.txt"
+            )
+        );
+    }
+    if (perf_path.has_value())
+    {
+        result.instructions =
+            count_instructions(
+                *perf_path,
+                build_command.output_path,
+                directory
+            );
+    }
+    return result;
+}
+
+void write_result(llvm::json::OStream& json, const BenchmarkResult& result)
+{
+    json.attribute("program", llvm::StringRef(result.program));
+    json.attribute("optimization", llvm::StringRef(result.optimization));
+    json.attribute("compile_seconds", result.compile_seconds);
+    r::write_benchmark_samples(json, "run_seconds", "median_seconds", result.run_seconds);
+    if (result.instructions.has_value())
+    {
+        json.attribute("instructions", static_cast<std::int64_t>(*result.instructions));
+    }
+    json.attribute("matches_o0_output", result.has_matching_output);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        llvm::SmallVector<std::string_view> programs{};
+        const r::BenchmarkOptions options =
+            r::parse_benchmark_arguments(
+                argc,
+                argv,
+                "runtime_benchmark",
+                5UZ,
+                [&](std::string_view option, llvm::function_ref<std::string_view()> take_value)
+                {
+                    if (option != "--program")
+                    {
+                        return false;
+                    }
+                    const std::string_view program = take_value();
+                    if (std::ranges::find(PROGRAMS, program) == std::end(PROGRAMS))
+                    {
+                        throw std::runtime_error(std::format("unknown program {}.", program));
+                    }
+                    programs.push_back(program);
+                    return true;
+                }
+            );
+        if (programs.empty())
+        {
+            programs.append(std::begin(PROGRAMS), std::end(PROGRAMS));
+        }
+        std::optional<std::string> perf_path{};
+        if (llvm::ErrorOr<std::string> found_perf_path = llvm::sys::findProgramByName("perf"))
+        {
+            perf_path = *found_perf_path;
+        }
+        else
+        {
+            std::cout << "perf was not found, so instructions are not counted.\n";
+        }
+        llvm::SmallVector<BenchmarkResult> results{};
+        bool has_mismatch = false;
+        for (std::string_view program : programs)
+        {
+            std::string o0_output{};
+            for (const OptimizationLevelName& optimization_level : OPTIMIZATION_LEVELS)
+            {
+                BenchmarkResult& result =
+                    results.emplace_back(
+                        run_benchmark(
+                            program,
+                            optimization_level,
+                            options.repetitions,
+                            options.work_directory,
+                            perf_path
+                        )
+                    );
+                const std::string output =
+                    r::read_file_text(
+                        options.work_directory / program / optimization_level.name / "output.txt"
+                    );
+                if (optimization_level.optimization_level == r::OptimizationLevel::O0)
+                {
+                    o0_output = output;
+                }
+                result.has_matching_output = output == o0_output;
+                has_mismatch = has_mismatch || !result.has_matching_output;
+                std::cout << std::format(
+                    "{:<16} {:<3} compile {:.3f}s run {:.4f}s{}{}\n",
+                    program,
+                    optimization_level.name,
+                    result.compile_seconds,
+                    r::get_median(result.run_seconds),
+                    result.instructions.has_value() ?
+                        std::format(" instructions {}", *result.instructions) :
+                        std::string(),
+                    result.has_matching_output ? "" : " OUTPUT DIFFERS FROM O0"
+                );
+            }
+        }
+        r::write_benchmark_results(
+            options.output_path,
+            results.size(),
+            [&](llvm::json::OStream& json, std::size_t result_i)
+            {
+                write_result(json, results[result_i]);
+            }
+        );
+        if (has_mismatch)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
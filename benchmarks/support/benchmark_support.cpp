@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <benchmark_support.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace r {
+
+r::BenchmarkOptions parse_benchmark_arguments(
+    int argc,
+    char** argv,
+    std::string_view name,
+    std::size_t default_repetitions,
+    r::BenchmarkOptionParser parse_option
+)
+{
+    r::BenchmarkOptions options;
+    options.repetitions = default_repetitions;
+    options.output_path = std::format("{}.json", name);
+    options.work_directory = std::filesystem::temp_directory_path() / std::format("requite_{}", name);
+    for (int arg_i = 1; arg_i < argc; arg_i++)
+    {
+        const std::string_view option = argv[arg_i];
+        const auto take_value =
+            [&]() -> std::string_view
+            {
+                if (arg_i + 1 == argc)
+                {
+                    throw std::runtime_error(std::format("missing value for {}.", option));
+                }
+                return argv[++arg_i];
+            };
+        if (option == "--repetitions")
+        {
+            options.repetitions = std::max(std::stoul(std::string(take_value())), 1UL);
+        }
+        else if (option == "--output")
+        {
+            options.output_path = take_value();
+        }
+        else if (option == "--work-directory")
+        {
+            options.work_directory = take_value();
+        }
+        else if (!parse_option(option, take_value))
+        {
+            throw std::runtime_error(std::format("unknown argument {}.", option));
+        }
+    }
+    return options;
+}
+
+double get_median(llvm::ArrayRef<double> values)
+{
+    assert(!values.empty());
+    llvm::SmallVector<double> sorted_values(values.begin(), values.end());
+    std::ranges::sort(sorted_values);
+    return sorted_values[sorted_values.size() / 2UZ];
+}
+
+void write_benchmark_results(
+    const std::filesystem::path& path,
+    std::size_t result_count,
+    llvm::function_ref<void(llvm::json::OStream& json, std::size_t result_i)> write_result
+)
+{
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    llvm::json::OStream json(ofile, 2U);
+    json.object(
+        [&]()
+        {
+            json.attributeArray(
+                "results",
+                [&]()
+                {
+                    for (std::size_t result_i = 0UZ; result_i < result_count; result_i++)
+                    {
+                        json.object(
+                            [&]()
+                            {
+                                write_result(json, result_i);
+                            }
+                        );
+                    }
+                }
+            );
+        }
+    );
+    ofile << '\n';
+}
+
+void write_benchmark_samples(
+    llvm::json::OStream& json,
+    llvm::StringRef name,
+    llvm::StringRef median_name,
+    llvm::ArrayRef<double> samples
+)
+{
+    json.attributeArray(
+        name,
+        [&]()
+        {
+            for (double sample : samples)
+            {
+                json.value(sample);
+            }
+        }
+    );
+    json.attribute(median_name, r::get_median(samples));
+}
+
+}
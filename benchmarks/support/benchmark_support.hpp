@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/STLFunctionalExtras.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/JSON.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace r {
+
+// the options every benchmark takes.
+struct BenchmarkOptions final
+{
+    std::size_t repetitions = 0UZ;
+    std::filesystem::path output_path{};
+    // generated files are written here instead of the source tree.
+    std::filesystem::path work_directory{};
+};
+
+// returns true if the option belongs to the benchmark. take_value returns the
+// argument that follows the option and throws if there is none.
+using BenchmarkOptionParser =
+    llvm::function_ref<bool(std::string_view option, llvm::function_ref<std::string_view()> take_value)>;
+
+// parses --repetitions, --output and --work-directory, and passes every other
+// option to parse_option. results go to <name>.json and generated files to
+// requite_<name> in the temp directory unless the arguments say otherwise.
+r::BenchmarkOptions parse_benchmark_arguments(
+    int argc,
+    char** argv,
+    std::string_view name,
+    std::size_t default_repetitions,
+    r::BenchmarkOptionParser parse_option
+);
+
+double get_median(llvm::ArrayRef<double> values);
+
+// writes a json object with a results array holding one object per result.
+void write_benchmark_results(
+    const std::filesystem::path& path,
+    std::size_t result_count,
+    llvm::function_ref<void(llvm::json::OStream& json, std::size_t result_i)> write_result
+);
+
+// writes every sample as an array and their median as a number beside it.
+void write_benchmark_samples(
+    llvm::json::OStream& json,
+    llvm::StringRef name,
+    llvm::StringRef median_name,
+    llvm::ArrayRef<double> samples
+);
+
+}
@@ -3,16 +3,27 @@
 // SPDX-License-Identifier: MIT
 
 #include <binary.hpp>
+#include <module/module.hpp>
+#include <object.hpp>
+#include <object_layout.hpp>
+#include <resolver/resolver.hpp>
 
 #include <llvm/IR/Type.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
 
 #include <string>
 #include <string_view>
 #include <memory>
 #include <stdexcept>
 #include <set>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
 
 namespace r {
 
@@ -25,11 +36,12 @@ r::Module& Binary::add_module()
 
 r::Module& Binary::get_module(std::string_view name)
 {
-    if (!this->module_map.contains(name))
+    auto module_iter = this->module_map.find(name);
+    if (module_iter == this->module_map.end())
     {
         throw std::runtime_error("module not found with name.");
     }
-    r::Module* module_ptr = this->module_map.at(name);
+    r::Module* module_ptr = module_iter->second;
     assert(module_ptr != nullptr);
     return *module_ptr;
 }
@@ -37,13 +49,13 @@ r::Module& Binary::get_module(std::string_view name)
 void Binary::map_modules()
 {
     assert(this->module_map.empty());
+    this->module_map.reserve(this->modules.size());
     for (r::Module& module : this->modules)
     {
-        if (this->module_map.contains(module.mangled_name))
+        if (!this->module_map.try_emplace(module.mangled_name, &module).second)
         {
             throw std::runtime_error("duplicate module with same name.");
         }
-        this->module_map[module.mangled_name] = &module;
     }
 }
 
@@ -123,8 +135,8 @@ void Binary::initialize_llvm_context()
     this->llvm_target_machine =
         this->llvm_target->createTargetMachine(
             this->llvm_target_triple,
-            "generic",
-            "",
+            this->target_cpu,
+            this->target_features,
             this->llvm_target_options,
             llvm::Reloc::PIC_
         );
@@ -141,4 +153,57 @@ r::ExportGroup& Binary::add_export_group()
     return *export_group_ptr.get();
 }
 
+void Binary::write_layout_report(const std::filesystem::path& path)
+{
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    r::Resolver resolver;
+    resolver.enter(*this);
+    llvm::json::OStream json(ofile, 2U);
+    json.object(
+        [&]()
+        {
+            json.attributeArray(
+                "objects",
+                [&]()
+                {
+                    for (r::Module& module : this->modules)
+                    {
+                        for (std::unique_ptr<r::Object>& object_ptr : module.objects)
+                        {
+                            assert(object_ptr.get() != nullptr);
+                            r::Object& object = *object_ptr.get();
+                            if (object.catalog_state == r::CatalogState::TABULATED)
+                            { // never used with a lazy catalog.
+                                continue;
+                            }
+                            const r::ObjectLayout& layout = resolver.get_object_layout(object);
+                            const std::size_t properties_byte_size = layout.byte_size - layout.padding_byte_size;
+                            json.object(
+                                [&]()
+                                {
+                                    json.attribute("module", module.mangled_name);
+                                    json.attribute("name", llvm::StringRef(object.name));
+                                    json.attribute("packed", object.is_packed);
+                                    json.attribute("reorders_properties", object.reorders_properties);
+                                    json.attribute("alignment", static_cast<std::int64_t>(layout.alignment));
+                                    json.attribute("declared_byte_size", static_cast<std::int64_t>(layout.declared_byte_size));
+                                    json.attribute("declared_padding_byte_size", static_cast<std::int64_t>(layout.declared_byte_size - properties_byte_size));
+                                    json.attribute("byte_size", static_cast<std::int64_t>(layout.byte_size));
+                                    json.attribute("padding_byte_size", static_cast<std::int64_t>(layout.padding_byte_size));
+                                }
+                            );
+                        }
+                    }
+                }
+            );
+        }
+    );
+    ofile << '\n';
+}
+
 }
\ No newline at end of file
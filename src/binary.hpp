@@ -7,15 +7,22 @@
 #include <module/module.hpp>
 #include <symbol_table.hpp>
 #include <export_group.hpp>
+#include <object_cache.hpp>
+#include <optimization_level.hpp>
+#include <profile_mode.hpp>
+#include <type_context.hpp>
 
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/Type.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
 
-#include <map>
+#include <filesystem>
 #include <string_view>
 #include <cstddef>
 #include <memory>
@@ -26,6 +33,9 @@ namespace r {
 struct BinaryBase
 {
     std::unique_ptr<llvm::LLVMContext> llvm_context;
+    // owns the context instead once run mode shares it with the jit, so it
+    // still outlives everything created in it.
+    llvm::orc::ThreadSafeContext llvm_thread_safe_context{};
 };
 
 struct Binary final : r::BinaryBase
@@ -35,14 +45,27 @@ struct Binary final : r::BinaryBase
     llvm::SmallVector<r::Module*, 1UZ> ordered_modules{};
     llvm::SmallVector<std::unique_ptr<r::ExportGroup>, 1UZ> export_groups{};
     r::SymbolTable table;
+    r::TypeContext type_context{};
 
     std::string llvm_target_triple{};
+    std::string target_cpu = "generic";
+    std::string target_features{};
     llvm::TargetOptions llvm_target_options{};
     const llvm::Target* llvm_target = nullptr;
     llvm::TargetMachine* llvm_target_machine = nullptr;
     std::unique_ptr<llvm::DataLayout> llvm_data_layout{};
 
-    std::map<std::string_view, r::Module*> module_map{};
+    llvm::DenseMap<llvm::StringRef, r::Module*> module_map{};
+
+    r::ObjectCache object_cache{};
+    r::OptimizationLevel optimization_level = r::OptimizationLevel::O0;
+    r::ProfileMode profile_mode = r::ProfileMode::NONE;
+    std::filesystem::path profile_path{};
+    bool debug_info = false;
+    bool optimization_remarks = false;
+    unsigned codegen_units = 1U;
+    bool reorder_properties = false;
+    bool lazy_catalog = false;
 
     r::Module& add_module();
     r::Module& get_module(std::string_view name);
@@ -51,6 +74,8 @@ struct Binary final : r::BinaryBase
     void determine_module_order();
     void initialize_llvm_context();
     r::ExportGroup& add_export_group();
+    // writes the size and padding of every object as json.
+    void write_layout_report(const std::filesystem::path& path);
 };
 
 }
\ No newline at end of file
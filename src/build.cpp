@@ -9,22 +9,80 @@
 #include <cataloger/cataloger.hpp>
 #include <llvm_extensions.hpp>
 #include <builder/builder.hpp>
+#include <file_io.hpp>
+
+#include <llvm/ADT/Statistic.h>
+#include <llvm/Support/raw_ostream.h>
 
 #include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#define DEBUG_TYPE "requite-ir"
+
+ALWAYS_ENABLED_STATISTIC(NumGeneratedInstructions, "ir instructions generated");
+ALWAYS_ENABLED_STATISTIC(NumOptimizedInstructions, "ir instructions after optimization");
 
 namespace r {
 
-void Compiler::build(const r::BuildCommand& build_command)
+namespace {
+
+void count_ir_instructions(r::Binary& binary, llvm::TrackingStatistic& statistic)
+{
+    if (!llvm::AreStatisticsEnabled())
+    {
+        return;
+    }
+    for (r::Module& module : binary.modules)
+    {
+        statistic += module.llvm_module->getInstructionCount();
+    }
+}
+
+}
+
+int Compiler::build(const r::BuildCommand& build_command)
 {
+    this->phase_timer.clear();
+    this->phase_timer.start("initialize");
+    if (
+        build_command.print_statistics ||
+        !build_command.statistics_path.empty()
+    )
+    { // counters only register while statistics are enabled.
+        llvm::ResetStatistics();
+        llvm::EnableStatistics(false);
+    }
     r::Binary binary;
+    binary.object_cache.directory = build_command.object_cache_directory;
+    binary.object_cache.max_size = build_command.object_cache_max_size;
+    binary.optimization_level = build_command.optimization_level;
+    binary.target_cpu = build_command.target_cpu;
+    binary.target_features = build_command.target_features;
+    binary.profile_mode = build_command.profile_mode;
+    binary.profile_path = build_command.profile_path;
+    binary.debug_info = build_command.debug_info;
+    binary.codegen_units = build_command.codegen_units;
+    binary.optimization_remarks = build_command.optimization_remarks;
+    binary.reorder_properties = build_command.reorder_properties;
+    binary.lazy_catalog = build_command.lazy_catalog;
+    if (
+        build_command.mode == r::BuildMode::RUN &&
+        build_command.profile_mode == r::ProfileMode::INSTRUMENT
+    )
+    {
+        throw std::runtime_error("instrumented builds need the profile runtime and can not be run in memory.");
+    }
     r::initialize_llvm();
     binary.initialize_llvm_context();
+    this->phase_timer.start("read_source");
     binary.modules.reserve(build_command.source_files.size());
     for (const std::filesystem::path& source_file : build_command.source_files)
     {
         r::Module& module = binary.add_module();
         module.read_source(source_file);
     }
+    this->phase_timer.start("parse_ast");
     for (r::Module& module : binary.modules)
     {
         module.parse_ast();
@@ -33,6 +91,7 @@ void Compiler::build(const r::BuildCommand& build_command)
     {
         //module.validate_ast();
     }
+    this->phase_timer.start("order_modules");
     for (r::Module& module : binary.modules)
     {
         module.determine_name();
@@ -48,6 +107,7 @@ void Compiler::build(const r::BuildCommand& build_command)
     }
     binary.check_no_circular_imports();
     binary.determine_module_order();
+    this->phase_timer.start("catalog");
     r::Cataloger cataloger;
     for (r::Module& module : binary.modules)
     {
@@ -58,13 +118,19 @@ void Compiler::build(const r::BuildCommand& build_command)
         cataloger.tabulate_extensions(module);
     }
     for (r::Module& module : binary.modules)
+    {
+        module.index_visible_symbols();
+    }
+    for (r::Module& module : binary.modules)
     {
         cataloger.catalog(module);
     }
+    this->phase_timer.start("resolve_type_aliases");
     for (r::Module& module : binary.modules)
     {
         module.resolve_type_aliases();
     }
+    this->phase_timer.start("generate_ir");
     //binary.generate_mangled_symbol_names();
     for (r::Module& module : binary.modules)
     {
@@ -77,19 +143,103 @@ void Compiler::build(const r::BuildCommand& build_command)
         assert(module_ptr != nullptr);
         builder.generate_prototypes(*module_ptr);
     }
+    builder.generate_reachable_procedures(binary);
     for (r::Module& module : binary.modules)
     {
-        builder.generate_module(module);
+        module.finalize_debug_info();
+    }
+    r::count_ir_instructions(binary, NumGeneratedInstructions);
+    if (!build_command.layout_report_path.empty())
+    {
+        this->phase_timer.start("write_layout_report");
+        binary.write_layout_report(build_command.layout_report_path);
     }
+    this->phase_timer.start("optimize");
     for (r::Module& module : binary.modules)
     {
-        module.write_ir_file();
+        module.optimize();
     }
+    r::count_ir_instructions(binary, NumOptimizedInstructions);
+    if (build_command.optimization_remarks)
+    {
+        this->phase_timer.start("write_optimization_remarks");
+        for (r::Module& module : binary.modules)
+        {
+            module.write_optimization_remarks();
+        }
+    }
+    if (build_command.ir_output != r::IrOutput::NONE)
+    {
+        this->phase_timer.start("write_ir");
+        for (r::Module& module : binary.modules)
+        {
+            module.write_ir_file(build_command.ir_output);
+        }
+    }
+    if (build_command.mode == r::BuildMode::RUN)
+    {
+        this->phase_timer.start("run");
+        const int exit_code = this->run(binary);
+        this->finish_build(build_command);
+        return exit_code;
+    }
+    this->phase_timer.start("compile");
     for (r::Module& module : binary.modules)
     {
         module.compile_intermediate_file();
     }
+    if (build_command.disassembly_listing)
+    {
+        this->phase_timer.start("write_disassembly_listing");
+        for (r::Module& module : binary.modules)
+        {
+            if (module.obj_paths.empty())
+            {
+                continue;
+            }
+            module.write_disassembly_listing();
+        }
+    }
+    if (build_command.throughput_report)
+    {
+        this->phase_timer.start("write_throughput_report");
+        for (r::Module& module : binary.modules)
+        {
+            if (module.obj_paths.empty())
+            {
+                continue;
+            }
+            module.write_throughput_report();
+        }
+    }
+    if (build_command.link_output != r::LinkOutput::NONE)
+    {
+        this->phase_timer.start("link");
+        this->link(binary, build_command);
+    }
     //std::system("clang");
+    this->finish_build(build_command);
+    return 0;
+}
+
+void Compiler::finish_build(const r::BuildCommand& build_command)
+{
+    this->phase_timer.stop();
+    if (!build_command.phase_timings_path.empty())
+    {
+        this->phase_timer.write_json(build_command.phase_timings_path);
+    }
+    if (build_command.print_statistics)
+    {
+        llvm::PrintStatistics(llvm::errs());
+    }
+    if (!build_command.statistics_path.empty())
+    {
+        std::string json{};
+        llvm::raw_string_ostream json_stream(json);
+        llvm::PrintStatisticsJSON(json_stream);
+        r::write_file_text(build_command.statistics_path, json_stream.str());
+    }
 }
 
 }
\ No newline at end of file
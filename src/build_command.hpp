@@ -4,15 +4,74 @@
 
 #pragma once
 
+#include <build_mode.hpp>
+#include <ir_output.hpp>
+#include <link_output.hpp>
+#include <optimization_level.hpp>
+#include <profile_mode.hpp>
+
 #include <llvm/ADT/SmallVector.h>
 
 #include <filesystem>
+#include <string>
+#include <cstdint>
 
 namespace r {
 
 struct BuildCommand final
 {
     llvm::SmallVector<std::filesystem::path> source_files{};
+    r::BuildMode mode = r::BuildMode::COMPILE;
+    r::IrOutput ir_output = r::IrOutput::NONE;
+    r::OptimizationLevel optimization_level = r::OptimizationLevel::O0;
+    std::string target_cpu = "generic";
+    std::string target_features{};
+    // writes the per procedure disassembly and code size of each object file.
+    bool disassembly_listing = false;
+    // writes a static throughput estimate of hot regions next to each
+    // object file.
+    bool throughput_report = false;
+    // emits dwarf line tables so debuggers and profilers can map machine
+    // code back to requite source.
+    bool debug_info = false;
+    // writes the remarks of the optimization pipeline for each module as
+    // json and as a summary. source lines are only known with debug_info.
+    bool optimization_remarks = false;
+    // large modules are split into this many parts after optimization, and
+    // the parts are compiled in parallel to separate object files.
+    unsigned codegen_units = 1U;
+    r::ProfileMode profile_mode = r::ProfileMode::NONE;
+    // the raw profile written by instrumented programs, or the indexed
+    // profile read when using a profile.
+    std::filesystem::path profile_path{};
+    r::LinkOutput link_output = r::LinkOutput::NONE;
+    std::filesystem::path output_path = "a.out";
+    // the compiler driver used to link, found on the PATH.
+    std::string linker = "clang";
+    // libraries passed to the linker as -l<name>. libc is always linked.
+    llvm::SmallVector<std::string> link_libraries = {"m"};
+    // the wall time of each build phase is written here as json when it is
+    // not empty.
+    std::filesystem::path phase_timings_path{};
+    // prints the compiler statistics counters to stderr after the build.
+    bool print_statistics = false;
+    // the compiler statistics counters are written here as json when it is
+    // not empty.
+    std::filesystem::path statistics_path{};
+    // reorders the properties of every object that is not packed to
+    // minimize padding. single objects opt in with reorder_properties.
+    bool reorder_properties = false;
+    // the size and padding of each object, in declaration order and as laid
+    // out, are written here as json when it is not empty. objects a lazy
+    // catalog never reached are left out.
+    std::filesystem::path layout_report_path{};
+    // procedures and objects are only cataloged once the build reaches them,
+    // so unused declarations of imported modules cost no type resolution.
+    // errors in declarations that are never reached are not reported.
+    bool lazy_catalog = false;
+    // object files are reused from this directory when it is not empty.
+    std::filesystem::path object_cache_directory{};
+    std::uintmax_t object_cache_max_size = 1024UZ * 1024UZ * 1024UZ;
 };
 
-}
\ No newline at end of file
+}
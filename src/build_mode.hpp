@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// What the compiler does with the generated modules.
+enum class BuildMode
+{
+    // emit an object file for each module.
+    COMPILE,
+    // compile the modules in memory and call the entry point.
+    RUN
+};
+
+}
@@ -7,7 +7,10 @@
 #include <opcode.hpp>
 #include <binary.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <stdexcept>
 
 namespace r {
     
@@ -20,10 +23,13 @@ llvm::Value* Builder::generate_bit_cast_value_expression(const r::Operation& ope
     this->resolver.check_type_assignable_to_type(dest_type, expected_type);
     const r::Expression& source_expression = operation.branches.back();
     r::Type src_type = this->resolver.deduce_type(source_expression, this);
-    // if (src_type.get_byte_size() != dest_type.get_byte_size())
-    // {
-    //     throw std::runtime_error("must bit cast between types of same byte sizes.");
-    // }
+    if (
+        !src_type.get_is_literal() &&
+        this->resolver.get_byte_size(src_type) != this->resolver.get_byte_size(dest_type)
+    )
+    {
+        throw std::runtime_error("must bit cast between types of same byte sizes.");
+    }
     llvm::Value* llvm_cast_value =
         this->generate_value_expression(
             operation.branches.back(),
@@ -42,10 +48,55 @@ llvm::Value* Builder::generate_bit_cast_value_expression(const r::Operation& ope
             );
 }
 
-void Builder::generate_bit_cast_store_expression(const r::Operation& operation, llvm::Value* llvm_store, const r::Type& type)
+void Builder::generate_bit_cast_store_expression(const r::Operation& operation, llvm::Value* llvm_store, const r::Type& expected_type)
 {
     assert(operation.opcode == r::Opcode::BIT_CAST);
-    // TODO use memcpy
+    assert(operation.branches.size() == 2UZ);
+    assert(llvm_store != nullptr);
+    const r::Expression& dest_type_expression = operation.branches.front();
+    r::Type dest_type = this->resolver.resolve_type(dest_type_expression);
+    this->resolver.check_type_assignable_to_type(dest_type, expected_type);
+    const r::Expression& source_expression = operation.branches.back();
+    r::Type src_type = this->resolver.deduce_type(source_expression, this);
+    src_type.clear_literals();
+    const std::size_t byte_size = this->resolver.get_byte_size(dest_type);
+    if (this->resolver.get_byte_size(src_type) != byte_size)
+    {
+        throw std::runtime_error("must bit cast between types of same byte sizes.");
+    }
+    if (src_type.get_is_llvm_value_type())
+    {
+        llvm::Value* llvm_cast_value =
+            this->generate_value_expression(
+                source_expression,
+                src_type
+            );
+        this->llvm_builder->
+            CreateStore(
+                llvm_cast_value,
+                llvm_store
+            );
+        return;
+    }
+    llvm::AllocaInst* llvm_temp =
+        this->generate_alloca(
+            this->resolver.get_llvm_type(src_type),
+            "bit_cast"
+        );
+    this->generate_store_expression(
+        source_expression,
+        llvm_temp,
+        src_type
+    );
+    this->generate_memcpy_static(
+        llvm_temp,
+        llvm_store,
+        byte_size,
+        std::min(
+            this->resolver.get_alignment(src_type),
+            this->resolver.get_alignment(dest_type)
+        )
+    );
 }
 
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <cstddef>
+#include <optional>
 
 namespace r {
 
@@ -46,12 +47,24 @@ struct Builder final
    llvm::StringMap<r::Local*> local_table{};
    llvm::StringMap<r::Label> label_table{};
    llvm::DenseMap<const r::Operation*, r::Temporary> temporary_table{};
+   // the deduced type of each operation in the current procedure. entries
+   // are listed under the scope they were deduced in and dropped with it,
+   // because the locals they were deduced from go with it.
+   llvm::DenseMap<const r::Operation*, r::Type> deduced_type_table{};
+   llvm::SmallVector<llvm::SmallVector<const r::Operation*>> deduced_type_scopes{};
+   // whether each operation in the current procedure is a compile-time
+   // constant, listed and dropped by scope the same way.
+   llvm::DenseMap<const r::Operation*, bool> constant_operation_table{};
+   llvm::SmallVector<llvm::SmallVector<const r::Operation*>> constant_operation_scopes{};
    llvm::SmallVector<llvm::BasicBlock*> llvm_continue_stack{};
    llvm::SmallVector<llvm::BasicBlock*> llvm_break_stack{};
 
    std::unique_ptr<llvm::IRBuilder<>> llvm_builder{};
    llvm::BasicBlock* current_block = nullptr;
 
+   // procedures that are reachable but whose bodies are not generated yet.
+   llvm::SmallVector<r::Procedure*> procedure_queue{};
+
    // llvm_builder.cpp
    void initialize(r::Binary& builder);
    bool get_is_initialized() const noexcept;
@@ -59,7 +72,7 @@ struct Builder final
 
    // module.cpp
    void generate_prototypes(r::Module& module);
-   void generate_module(r::Module& module);
+   void generate_reachable_procedures(r::Binary& binary);
 
 
 private:
@@ -95,6 +108,7 @@ private:
    */
 
    // procedures.cpp
+   llvm::Function* get_llvm_function(r::Procedure& procedure);
    void generate_prototype(r::Procedure& procedure);
    void generate_body(r::Procedure& procedure);
    void generate_appended_return(r::Procedure& procedure);
@@ -106,6 +120,11 @@ private:
    llvm::Value* generate_property_location(r::Object& object, llvm::Value* llvm_object_location, std::string_view name);
    llvm::Value* generate_this_location(const r::Operation& operation);
 
+   // debug_info.cpp
+   void generate_debug_subprogram(r::Procedure& procedure);
+   void set_debug_location(const r::Operation& operation);
+   void clear_debug_location();
+
    // blocks.cpp
    llvm::BasicBlock* create_block(std::string_view name);
    void set_current_block(llvm::BasicBlock* block);
@@ -134,6 +153,10 @@ private:
    r::Temporary& get_temporary(const r::Operation* operation_ptr);
 public:
    r::Local* try_get_local(std::string_view name);
+   const r::Type* try_get_deduced_type(const r::Operation& operation) const;
+   void add_deduced_type(const r::Operation& operation, const r::Type& type);
+   std::optional<bool> try_get_is_constant(const r::Operation& operation) const;
+   void add_is_constant(const r::Operation& operation, bool is_constant);
 private:
    r::Temporary* try_get_temporary(const r::Operation* operation_ptr);
    void generate_local(r::Local& local, llvm::Value* llvm_dynamic_array_size = nullptr);
@@ -148,6 +171,7 @@ private:
    // constant.cpp
    llvm::Value* generate_primitive_literal(const r::Literal& literal, bool is_negative, const r::Type& expected_type);
    llvm::ConstantInt* generate_integer_constant(llvm::APSInt llvm_ap_sint, const r::Type& type);
+   llvm::Constant* generate_constant(const r::Constant& constant);
    llvm::GlobalVariable* generate_global_string(const r::Literal& literal);
 
    // sign.cpp
@@ -325,11 +349,14 @@ private:
    void check_is_null_value_expression(const r::Expression& expression);
 
    // memcpy.cpp
-   void generate_memcpy_static(llvm::Value* llvm_source, llvm::Value* llvm_dest, std::size_t size);
+   void generate_memcpy_static(llvm::Value* llvm_source, llvm::Value* llvm_dest, std::size_t size, std::size_t alignment = 1UZ);
    void generate_memcpy(llvm::Value* llvm_source, llvm::Value* llvm_dest, llvm::Value* llvm_size);
 
    // pointer_depth.cpp
    llvm::ConstantInt* generate_pointer_depth_value_expression(const r::Operation& operation, const r::Type& expected_type);
+
+   // size_of.cpp
+   llvm::ConstantInt* generate_size_of_value_expression(const r::Operation& operation, const r::Type& expected_type);
 };
 
 }
\ No newline at end of file
@@ -82,9 +82,10 @@ void Builder::generate_call_statement(const r::Operation& operation)
     llvm_arguments.reserve(argument_count);
     if (callee.get_has_sret())
     {
-        r::Type sret_type = callee.get_sret_type();
-        llvm::Type* llvm_sret_type = this->resolver.get_llvm_type(sret_type);
-        llvm::AllocaInst* llvm_temp = this->generate_alloca(llvm_sret_type, "temp");
+        // the callee writes the whole return object through the sret pointer.
+        llvm::Type* llvm_return_type = this->resolver.get_llvm_type(callee.return_type);
+        llvm::AllocaInst* llvm_temp = this->generate_alloca(llvm_return_type, "temp");
+        llvm_temp->setAlignment(llvm::Align(this->resolver.get_alignment(callee.return_type)));
         llvm_arguments.push_back(llvm_temp);
     }
     if (callee.get_is_instanced())
@@ -98,7 +99,7 @@ void Builder::generate_call_statement(const r::Operation& operation)
     this->generate_call_arguments(callee, operation, llvm_arguments);
     this->llvm_builder->
         CreateCall(
-            callee.llvm_function,
+            this->get_llvm_function(callee),
             llvm_arguments,
             "call_statement"
         );
@@ -137,7 +138,7 @@ llvm::Value* Builder::generate_call_value_expression(const r::Operation& operati
     llvm::Value* llvm_return =
         this->llvm_builder->
             CreateCall(
-                callee.llvm_function,
+                this->get_llvm_function(callee),
                 llvm_arguments,
                 "call_value"
             );
@@ -178,7 +179,7 @@ void Builder::generate_call_store_expression(const r::Operation& operation, llvm
     this->generate_call_arguments(callee, operation, llvm_arguments);
     this->llvm_builder->
         CreateCall(
-            callee.llvm_function,
+            this->get_llvm_function(callee),
             llvm_arguments,
             "call_store"
         );
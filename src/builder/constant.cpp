@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <builder/builder.hpp>
+#include <constant.hpp>
 #include <literal.hpp>
 #include <type.hpp>
 #include <binary.hpp>
@@ -15,6 +16,7 @@
 
 #include <string>
 #include <cassert>
+#include <variant>
 
 namespace r {
 
@@ -103,6 +105,31 @@ llvm::ConstantInt* Builder::generate_integer_constant(llvm::APSInt llvm_ap_sint,
         );
 }
 
+llvm::Constant* Builder::generate_constant(const r::Constant& constant)
+{
+    if (std::holds_alternative<llvm::APSInt>(constant.value))
+    {
+        return
+            this->generate_integer_constant(
+                std::get<llvm::APSInt>(constant.value),
+                constant.type
+            );
+    }
+    else if (std::holds_alternative<llvm::APFloat>(constant.value))
+    {
+        return
+            llvm::ConstantFP::get(
+                this->resolver.get_llvm_context(),
+                std::get<llvm::APFloat>(constant.value)
+            );
+    }
+    return
+        llvm::ConstantInt::getBool(
+            this->resolver.get_llvm_context(),
+            std::get<bool>(constant.value)
+        );
+}
+
 llvm::GlobalVariable* Builder::generate_global_string(const r::Literal& literal)
 { // TODO encodings
     if (literal.type != r::LiteralType::STRING)
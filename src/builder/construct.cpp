@@ -198,7 +198,7 @@ void Builder::generate_construct_store_expression(const r::Operation& operation,
         }
         this->llvm_builder->
             CreateCall(
-                callee.llvm_function,
+                this->get_llvm_function(callee),
                 llvm_arguments,
                 "call"
             );
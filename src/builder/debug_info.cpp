@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <builder/builder.hpp>
+#include <binary.hpp>
+#include <module/module.hpp>
+#include <object.hpp>
+#include <operation.hpp>
+#include <procedure.hpp>
+#include <source_location.hpp>
+
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/DebugLoc.h>
+
+#include <cassert>
+
+namespace r {
+
+void Builder::generate_debug_subprogram(r::Procedure& procedure)
+{
+    assert(procedure.module != nullptr);
+    assert(procedure.llvm_function != nullptr);
+    r::Module& module = *procedure.module;
+    if (module.llvm_di_builder == nullptr)
+    {
+        return;
+    }
+    // default procedures have no declaration, so they are placed at their
+    // object.
+    const r::Operation* declaration = procedure.declaration;
+    if (declaration == nullptr && procedure.object != nullptr)
+    {
+        declaration = procedure.object->declaration;
+    }
+    unsigned line = 0U;
+    if (declaration != nullptr)
+    {
+        line = module.get_source_location(declaration->source_i).line;
+    }
+    // argument types are not described, which is enough for line tables.
+    llvm::DISubroutineType* llvm_di_type =
+        module.llvm_di_builder->createSubroutineType(
+            module.llvm_di_builder->getOrCreateTypeArray({})
+        );
+    llvm::DISubprogram::DISPFlags llvm_di_flags = llvm::DISubprogram::SPFlagDefinition;
+    if (procedure.llvm_function->hasLocalLinkage())
+    {
+        llvm_di_flags |= llvm::DISubprogram::SPFlagLocalToUnit;
+    }
+    if (module.binary->optimization_level != r::OptimizationLevel::O0)
+    {
+        llvm_di_flags |= llvm::DISubprogram::SPFlagOptimized;
+    }
+    llvm::DISubprogram* llvm_di_subprogram =
+        module.llvm_di_builder->createFunction(
+            module.llvm_di_file,
+            procedure.get_qualified_name(),
+            procedure.mangled_name,
+            module.llvm_di_file,
+            line,
+            llvm_di_type,
+            line,
+            llvm::DINode::FlagPrototyped,
+            llvm_di_flags
+        );
+    procedure.llvm_function->setSubprogram(llvm_di_subprogram);
+    this->llvm_builder->SetCurrentDebugLocation(
+        llvm::DILocation::get(
+            this->resolver.get_llvm_context(),
+            line,
+            0U,
+            llvm_di_subprogram
+        )
+    );
+}
+
+void Builder::set_debug_location(const r::Operation& operation)
+{
+    assert(this->resolver.module != nullptr);
+    if (this->resolver.module->llvm_di_builder == nullptr)
+    {
+        return;
+    }
+    llvm::DISubprogram* llvm_di_subprogram = this->resolver.get_llvm_function()->getSubprogram();
+    assert(llvm_di_subprogram != nullptr);
+    const r::SourceLocation location =
+        this->resolver.module->get_source_location(
+            operation.source_i
+        );
+    this->llvm_builder->SetCurrentDebugLocation(
+        llvm::DILocation::get(
+            this->resolver.get_llvm_context(),
+            location.line,
+            location.column,
+            llvm_di_subprogram
+        )
+    );
+}
+
+void Builder::clear_debug_location()
+{
+    this->llvm_builder->SetCurrentDebugLocation(llvm::DebugLoc());
+}
+
+}
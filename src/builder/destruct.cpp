@@ -8,8 +8,14 @@
 #include <object.hpp>
 #include <procedure.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <cassert>
 
+#define DEBUG_TYPE "requite-builder"
+
+ALWAYS_ENABLED_STATISTIC(NumDestructorCalls, "destructor calls emitted");
+
 namespace r {
 
 void Builder::generate_desruct_statement(const r::Operation& operation)
@@ -30,9 +36,10 @@ void Builder::generate_destruct(const r::Expression& expression)
             expression,
             false
         );
+    ++NumDestructorCalls;
     this->llvm_builder->
         CreateCall(
-            destructor.llvm_function,
+            this->get_llvm_function(destructor),
             {llvm_location},
             "destruct"
         );
@@ -48,9 +55,10 @@ void Builder::generate_destruct(r::Local& local)
     if (object.get_has_destructor())
     {
         r::Procedure& destructor = object.get_destructor();
+        ++NumDestructorCalls;
         this->llvm_builder->
             CreateCall(
-                destructor.llvm_function,
+                this->get_llvm_function(destructor),
                 {local.llvm_alloca},
                 "destruct"
             );
@@ -71,9 +79,10 @@ void Builder::generate_destruct(r::Temporary& temporary)
     if (object.get_has_destructor())
     {
         r::Procedure& destructor = object.get_destructor();
+        ++NumDestructorCalls;
         this->llvm_builder->
             CreateCall(
-                destructor.llvm_function,
+                this->get_llvm_function(destructor),
                 {temporary.llvm_alloca},
                 "destruct"
             );
@@ -98,9 +107,10 @@ void Builder::generate_autodestruct_object(r::Object& object, llvm::Value* llvm_
         if (property_object.get_has_destructor())
         {
             r::Procedure& destructor = property_object.get_destructor();
+            ++NumDestructorCalls;
             this->llvm_builder->
                 CreateCall(
-                    destructor.llvm_function,
+                    this->get_llvm_function(destructor),
                     {llvm_object_location},
                     "destruct"
                 );
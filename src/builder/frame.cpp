@@ -9,8 +9,15 @@
 #include <object.hpp>
 #include <binary.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <span>
 #include <cassert>
+#include <optional>
+
+#define DEBUG_TYPE "requite-builder"
+
+ALWAYS_ENABLED_STATISTIC(NumTemporaries, "temporaries created");
 
 namespace r {
 
@@ -58,6 +65,8 @@ void Builder::generate_arguments()
 void Builder::push_scope()
 {
     this->scopes.emplace_back();
+    this->deduced_type_scopes.emplace_back();
+    this->constant_operation_scopes.emplace_back();
 }
 
 void Builder::pop_scope()
@@ -73,6 +82,18 @@ void Builder::pop_scope()
     }
     this->locals.erase(this->locals.end() - top_scope.size(), this->locals.end());
     this->scopes.pop_back();
+    assert(!this->deduced_type_scopes.empty());
+    for (const r::Operation* operation_ptr : this->deduced_type_scopes.back())
+    {
+        this->deduced_type_table.erase(operation_ptr);
+    }
+    this->deduced_type_scopes.pop_back();
+    assert(!this->constant_operation_scopes.empty());
+    for (const r::Operation* operation_ptr : this->constant_operation_scopes.back())
+    {
+        this->constant_operation_table.erase(operation_ptr);
+    }
+    this->constant_operation_scopes.pop_back();
 }
 
 void Builder::finish_frame()
@@ -88,6 +109,10 @@ void Builder::finish_frame()
     this->locals.clear();
     this->scopes.clear();
     this->local_table.clear();
+    this->deduced_type_table.clear();
+    this->deduced_type_scopes.clear();
+    this->constant_operation_table.clear();
+    this->constant_operation_scopes.clear();
 }
 
 void Builder::clear_temporaries()
@@ -146,9 +171,54 @@ r::Temporary* Builder::try_get_temporary(const r::Operation* operation_ptr)
     return &this->temporary_table[operation_ptr];
 }
 
+const r::Type* Builder::try_get_deduced_type(const r::Operation& operation) const
+{
+    auto deduced_type_iter = this->deduced_type_table.find(&operation);
+    if (deduced_type_iter == this->deduced_type_table.end())
+    {
+        return nullptr;
+    }
+    return &deduced_type_iter->second;
+}
+
+void Builder::add_deduced_type(const r::Operation& operation, const r::Type& type)
+{
+    if (this->deduced_type_scopes.empty())
+    { // outside of a procedure body there are no locals to go out of scope with.
+        return;
+    }
+    if (this->deduced_type_table.try_emplace(&operation, type).second)
+    {
+        this->deduced_type_scopes.back().push_back(&operation);
+    }
+}
+
+std::optional<bool> Builder::try_get_is_constant(const r::Operation& operation) const
+{
+    auto is_constant_iter = this->constant_operation_table.find(&operation);
+    if (is_constant_iter == this->constant_operation_table.end())
+    {
+        return std::nullopt;
+    }
+    return is_constant_iter->second;
+}
+
+void Builder::add_is_constant(const r::Operation& operation, bool is_constant)
+{
+    if (this->constant_operation_scopes.empty())
+    { // outside of a procedure body there are no locals to go out of scope with.
+        return;
+    }
+    if (this->constant_operation_table.try_emplace(&operation, is_constant).second)
+    {
+        this->constant_operation_scopes.back().push_back(&operation);
+    }
+}
+
 r::Temporary& Builder::add_temporary(const r::Operation* operation_ptr, const r::Type& type)
 {
     assert(!this->temporary_table.contains(operation_ptr));
+    ++NumTemporaries;
     r::Temporary& temporary = this->temporary_table[operation_ptr];
     temporary.type = type;
     return temporary;
@@ -196,6 +266,8 @@ void Builder::generate_temporary(r::Temporary& temporary, llvm::Value* llvm_dyna
 llvm::AllocaInst* Builder::generate_alloca(llvm::Type* llvm_type, std::string_view name, llvm::Value* llvm_dynamic_array_size)
 {
     llvm::IRBuilderBase::InsertPoint old_insertion_point = this->llvm_builder->saveAndClearIP();
+    // moving the insertion point also moves the debug location.
+    const llvm::DebugLoc old_debug_location = this->llvm_builder->getCurrentDebugLocation();
     this->llvm_builder->
         SetInsertPointPastAllocas(
             this->resolver.get_llvm_function()
@@ -223,6 +295,7 @@ llvm::AllocaInst* Builder::generate_alloca(llvm::Type* llvm_type, std::string_vi
                 );  
     }
     this->llvm_builder->restoreIP(old_insertion_point);
+    this->llvm_builder->SetCurrentDebugLocation(old_debug_location);
     return llvm_alloca;
 }
 
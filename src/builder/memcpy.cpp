@@ -5,19 +5,40 @@
 #include <builder/builder.hpp>
 
 #include <llvm/IR/Value.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/Support/Alignment.h>
 
 #include <cstddef>
 
 namespace r {
 
-void Builder::generate_memcpy_static(llvm::Value* llvm_source, llvm::Value* llvm_dest, std::size_t size)
+void Builder::generate_memcpy_static(llvm::Value* llvm_source, llvm::Value* llvm_dest, std::size_t size, std::size_t alignment)
 {
-    // TODO with IRBuilder::CreateMemcpyInline
+    llvm::Value* llvm_size =
+        llvm::ConstantInt::get(
+            this->resolver.get_llvm_size_type(),
+            size
+        );
+    this->llvm_builder->
+        CreateMemCpyInline(
+            llvm_dest,
+            llvm::Align(alignment),
+            llvm_source,
+            llvm::Align(alignment),
+            llvm_size
+        );
 }
 
 void Builder::generate_memcpy(llvm::Value* llvm_source, llvm::Value* llvm_dest, llvm::Value* llvm_size)
 {
-    // TODO with IRBuilder::CreateMemcpy
+    this->llvm_builder->
+        CreateMemCpy(
+            llvm_dest,
+            llvm::MaybeAlign(),
+            llvm_source,
+            llvm::MaybeAlign(),
+            llvm_size
+        );
 }
 
-}
\ No newline at end of file
+}
@@ -4,6 +4,9 @@
 
 #include <builder/builder.hpp>
 #include <module/module.hpp>
+#include <binary.hpp>
+#include <procedure.hpp>
+#include <object.hpp>
 
 namespace r {
 
@@ -13,21 +16,39 @@ void Builder::generate_prototypes(r::Module& module)
     {
         assert(object_ptr.get() != nullptr);
         r::Object& object = *object_ptr.get();
+        if (object.catalog_state != r::CatalogState::CATALOGED)
+        { // left for the first use with a lazy catalog.
+            continue;
+        }
         this->generate_prototype(object);
     }
-    for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
-    {
-        assert(procedure_ptr.get() != nullptr);
-        r::Procedure& procedure = *procedure_ptr.get();
-        this->generate_prototype(procedure);
-    }
 }
 
-void Builder::generate_module(r::Module& module)
+void Builder::generate_reachable_procedures(r::Binary& binary)
 {
-    for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+    // only procedures reachable from the entry point or an export are
+    // generated. the rest are never declared, so unused external functions
+    // and dead code do not reach codegen.
+    assert(this->procedure_queue.empty());
+    if (binary.entry_point != nullptr)
+    {
+        this->get_llvm_function(*binary.entry_point);
+    }
+    for (r::Module& module : binary.modules)
+    {
+        for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+        {
+            assert(procedure_ptr.get() != nullptr);
+            r::Procedure& procedure = *procedure_ptr.get();
+            if (procedure.export_group != nullptr)
+            {
+                this->get_llvm_function(procedure);
+            }
+        }
+    }
+    while (!this->procedure_queue.empty())
     {
-        r::Procedure& procedure = *procedure_ptr.get();
+        r::Procedure& procedure = *this->procedure_queue.pop_back_val();
         this->generate_body(procedure);
     }
 }
@@ -6,12 +6,14 @@
 #include <module/module.hpp>
 #include <object.hpp>
 #include <property.hpp>
+#include <object_layout.hpp>
 #include <utility.hpp>
 
 #include <llvm/IR/Type.h>
 #include <llvm/IR/DerivedTypes.h>
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <ranges>
 
@@ -19,44 +21,10 @@ namespace r {
 
 void Builder::generate_prototype(r::Object& object)
 {
-    r::Resolver old_resolver = this->resolver;
-    this->resolver.enter(object);
-    llvm::SmallVector<llvm::Type*> llvm_property_types{};
-    llvm_property_types.reserve(object.properties.size());
-    for (std::unique_ptr<r::Property>& property_ptr : object.properties)
-    {
-        assert(property_ptr.get() != nullptr);
-        r::Property& property = *property_ptr.get();
-        if (property.type.get_is_object())
-        {
-            r::Object* property_object_ptr = std::get<r::Object*>(property.type.root);
-            assert(property_object_ptr != nullptr);
-            r::Object& property_object = *property_object_ptr;
-            assert(property_object.module != nullptr);
-            if (property_object.module == object.module)
-            {
-                if (property_object.module_symbol_i > object.module_symbol_i)
-                {
-                    throw std::runtime_error("property object must be defined higher in source file.");
-                }
-            }
-            else if (!this->resolver.module->import_set.contains(property_object.module->mangled_name))
-            {
-                throw std::runtime_error("property object from other module must be imported.");
-            }
-        }
-        llvm::Type*& llvm_type = llvm_property_types.emplace_back();
-        llvm_type = this->resolver.get_llvm_type(property.type);        
-    }
-    object.llvm_struct_type =
-        llvm::StructType::
-            create(
-                this->resolver.get_llvm_context(),
-                llvm_property_types,
-                object.name,
-                object.is_packed
-            );
-    this->resolver = old_resolver;
+    // the struct type is created by the resolver the first time it is
+    // needed, with its fields in layout order. this only creates the types
+    // of objects in the order the module declares them.
+    this->resolver.get_llvm_type(object);
 }
 
 void Builder::generate_property_initializers(r::Procedure& procedure)
@@ -154,24 +122,14 @@ llvm::Value* Builder::generate_owner_location(const r::Expression& expression)
 llvm::Value* Builder::generate_property_location(r::Object& object, llvm::Value* llvm_object_location, std::string_view name)
 {
     r::Property& property = object.get_property(name);
-    llvm::Type* llvm_property_type = 
-        object.llvm_struct_type->
-            getElementType(
-                property.property_i
-            );
-    llvm::ConstantInt* llvm_property_i =
-        llvm::ConstantInt::get(
-            llvm::Type::getInt64Ty(this->resolver.get_llvm_context()),
-            property.property_i
-        );
+    const r::ObjectLayout& layout = this->resolver.get_object_layout(object);
     llvm::Value* llvm_property_location =
         this->llvm_builder->
-            CreateGEP(
-                llvm_property_type,
+            CreateStructGEP(
+                object.llvm_struct_type,
                 llvm_object_location,
-                {llvm_property_i},
-                "property_ptr",
-                true
+                layout.property_fields[property.property_i],
+                "property_ptr"
             );
     return llvm_property_location;
 }
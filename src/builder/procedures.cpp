@@ -13,6 +13,7 @@
 #include <local.hpp>
 
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <ranges>
 #include <cstddef>
@@ -22,11 +23,31 @@
 
 namespace r {
 
+llvm::Function* Builder::get_llvm_function(r::Procedure& procedure)
+{
+    if (procedure.llvm_function != nullptr)
+    {
+        return procedure.llvm_function;
+    }
+    // prototypes are generated the first time a procedure is used, so this
+    // may happen while another procedure is being generated.
+    const r::Resolver resolver = this->resolver;
+    this->generate_prototype(procedure);
+    this->resolver = resolver;
+    if (procedure.category != r::ProcedureCategory::EXTERNAL_FUNCTION)
+    {
+        this->procedure_queue.push_back(&procedure);
+    }
+    return procedure.llvm_function;
+}
+
 void Builder::generate_prototype(r::Procedure& procedure)
 {
     assert(procedure.llvm_type == nullptr);
     assert(procedure.llvm_function == nullptr);
 
+    this->resolver.ensure_cataloged(procedure);
+
     this->resolver.enter(procedure);
 
     llvm::Type* llvm_return_type = nullptr;
@@ -110,13 +131,26 @@ void Builder::generate_prototype(r::Procedure& procedure)
         llvm::Function::ExternalLinkage :
         llvm::Function::InternalLinkage;
 
+    // internal procedures without a mangled name are named after their
+    // module and declaration, so reports can tell them apart.
+    const std::string llvm_name =
+        (procedure.mangled_name.empty() && llvm_linkage == llvm::Function::InternalLinkage) ?
+        std::format(
+            "{}.{}.{}",
+            procedure.module->mangled_name,
+            procedure.get_qualified_name(),
+            procedure.module_symbol_i
+        ) :
+        procedure.mangled_name;
+
     procedure.llvm_function =
         llvm::Function::Create(
             procedure.llvm_type,
             llvm_linkage,
-            procedure.mangled_name,
+            llvm_name,
             procedure.module->llvm_module.get()
         );
+    procedure.symbol_name = procedure.llvm_function->getName().str();
 
     llvm::Argument* llvm_arg = procedure.llvm_function->arg_begin();
 
@@ -124,11 +158,29 @@ void Builder::generate_prototype(r::Procedure& procedure)
     {
         llvm_arg->
             addAttr(
-                llvm::Attribute::get(
+                llvm::Attribute::getWithStructRetType(
                     this->resolver.get_llvm_context(),
-                    llvm::Attribute::StructRet
+                    this->resolver.get_llvm_type(procedure.return_type)
                 )
             );
+        llvm_arg->
+            addAttr(
+                llvm::Attribute::getWithAlignment(
+                    this->resolver.get_llvm_context(),
+                    llvm::Align(this->resolver.get_alignment(procedure.return_type))
+                )
+            );
+        const std::size_t sret_byte_size = this->resolver.get_byte_size(procedure.return_type);
+        if (sret_byte_size != 0UZ)
+        {
+            llvm_arg->
+                addAttr(
+                    llvm::Attribute::getWithDereferenceableBytes(
+                        this->resolver.get_llvm_context(),
+                        sret_byte_size
+                    )
+                );
+        }
         if (procedure.get_is_constructor())
         {
             llvm_arg->setName("_____sret_this");
@@ -178,6 +230,8 @@ void Builder::generate_body(r::Procedure& procedure)
 
     this->resolver.enter(procedure);
 
+    this->generate_debug_subprogram(procedure);
+
     this->push_scope();
 
     llvm::BasicBlock* entry_block = 
@@ -207,6 +261,7 @@ void Builder::generate_body(r::Procedure& procedure)
         assert(this->scopes.empty());
         this->current_block = nullptr;
         this->llvm_builder->ClearInsertionPoint();
+        this->clear_debug_location();
         return;
     }
 
@@ -239,6 +294,7 @@ void Builder::generate_body(r::Procedure& procedure)
     this->finish_frame();
     this->current_block = nullptr;
     this->llvm_builder->ClearInsertionPoint();
+    this->clear_debug_location();
 }
 
 void Builder::generate_appended_return(r::Procedure& procedure)
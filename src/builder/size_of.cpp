@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <builder/builder.hpp>
+#include <operation.hpp>
+#include <type.hpp>
+
+#include <llvm/ADT/APInt.h>
+#include <llvm/IR/Constants.h>
+
+#include <array>
+#include <cstddef>
+#include <cassert>
+#include <cstdint>
+
+namespace r {
+
+llvm::ConstantInt* Builder::generate_size_of_value_expression(const r::Operation& operation, const r::Type& expected_type)
+{
+    assert(operation.opcode == r::Opcode::SIZE_OF);
+    std::size_t byte_size = this->resolver.get_size_of(operation, this);
+    r::Type uptr_type = this->resolver.get_uptr_type();
+    this->resolver.check_type_assignable_to_type(uptr_type, expected_type);
+    llvm::APInt llvm_ap_int(
+        this->resolver.get_pointer_bit_depth(),
+        std::to_array({static_cast<std::uint64_t>(byte_size)})
+    );
+    return
+        llvm::ConstantInt::get(
+            this->resolver.get_llvm_context(),
+            llvm_ap_int
+        );
+}
+
+}
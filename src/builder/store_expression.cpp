@@ -40,6 +40,9 @@ void Builder::generate_store_expression(const r::Expression& expression, llvm::V
             case r::Opcode::CALL:
                 this->generate_call_store_expression(operation, llvm_store, expected_type);
                 break;
+            case r::Opcode::BIT_CAST:
+                this->generate_bit_cast_store_expression(operation, llvm_store, expected_type);
+                break;
             default:
                 r::unreachable();
         }
@@ -3,11 +3,20 @@
 // SPDX-License-Identifier: MIT
 
 #include <builder/builder.hpp>
+#include <constant.hpp>
 #include <operation.hpp>
 #include <opcode.hpp>
+#include <type.hpp>
 #include <utility.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <cassert>
+#include <optional>
+
+#define DEBUG_TYPE "requite-builder"
+
+ALWAYS_ENABLED_STATISTIC(NumFoldedConstants, "constant expressions folded before emission");
 
 namespace r {
 
@@ -19,6 +28,27 @@ llvm::Value* Builder::attribute_value_expression(const r::Operation& operation,
 
 llvm::Value* Builder::generate_value_expression(const r::Expression& expression, const r::Type& expected_type)
 {
+    if (
+        !std::holds_alternative<r::Literal>(expression) &&
+        (
+            expected_type.get_is_integer() ||
+            expected_type.get_is_floating_point() ||
+            expected_type.get_is_bool()
+        )
+    )
+    { // globals and operations on constants are emitted as their value.
+        std::optional<r::Constant> constant =
+            this->resolver.try_get_constant(
+                expression,
+                expected_type,
+                this
+            );
+        if (constant.has_value())
+        {
+            ++NumFoldedConstants;
+            return this->generate_constant(constant.value());
+        }
+    }
     if (std::holds_alternative<std::string_view>(expression))
     {
         std::string_view name = std::get<std::string_view>(expression);
@@ -110,6 +140,8 @@ llvm::Value* Builder::generate_value_expression(const r::Expression& expression,
                 return this->generate_bitwise_or_assignment_value_expression(operation, expected_type);
             case r::Opcode::POINTER_DEPTH:
                 return this->generate_pointer_depth_value_expression(operation, expected_type);
+            case r::Opcode::SIZE_OF:
+                return this->generate_size_of_value_expression(operation, expected_type);
             case r::Opcode::CAROT:
                 return this->generate_bitwise_xor_value_expression(operation, expected_type);
             case r::Opcode::CAROT_EQUAL:
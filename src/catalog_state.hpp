@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// how far a symbol has been cataloged. with lazy cataloging, symbols stay
+// tabulated until the resolver or builder first needs them.
+enum class CatalogState
+{
+    TABULATED,
+    CATALOGING,
+    CATALOGED
+};
+
+}
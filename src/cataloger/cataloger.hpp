@@ -26,6 +26,11 @@ struct Cataloger final
     void tabulate(r::Module& module);
     void tabulate_extensions(r::Module& module);
     void catalog(r::Module& module);
+    // catalogs a symbol skipped by a lazy catalog, once it is needed after
+    // type aliases may already have been resolved.
+    void catalog_on_demand(r::Procedure& procedure);
+    void catalog_on_demand(r::Object& object);
+    void catalog_on_demand(r::Global& global);
 private:
     // catalog.cpp
     void tabulate(const r::Operation& operation);
@@ -39,7 +44,7 @@ private:
 
     // global.cpp    
     void tabulate_global(const r::Operation& operation, const r::Operation* attributes_operation = nullptr);
-    void catalog(r::Global& export_group);
+    void catalog(r::Global& global);
 
     // object_extension.cpp
     void tabulate_object_extension(const r::Operation& operation);
@@ -48,6 +53,7 @@ private:
     // object.cpp
     void tabulate_object(const r::Operation& operation, const r::Operation* attributes_operation = nullptr);
     void catalog(r::Object& object);
+    void check_valid(const r::Object& object);
 
     // property.cpp
     void tabulate_property(const r::Operation& operation, const r::Operation* attributes_operation = nullptr);
@@ -58,6 +64,7 @@ private:
     void catalog(r::Procedure& procedure);
     void catalog_calling_convention(r::Procedure& procedure);
     void catalog_variadic_arguments(r::Procedure& procedure);
+    void catalog_analyze_throughput(r::Procedure& procedure);
     void catalog_user_mangled_name(r::Procedure& procedure);
     void catalog_arguments(r::Procedure& procedure);
     void catalog_return_type(r::Procedure& procedure);
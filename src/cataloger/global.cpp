@@ -6,10 +6,19 @@
 #include <operation.hpp>
 #include <module/module.hpp>
 #include <global.hpp>
+#include <type_alias.hpp>
+#include <constant.hpp>
+
+#include <llvm/ADT/Statistic.h>
 
 #include <cassert>
+#include <stdexcept>
 #include <string_view>
 
+#define DEBUG_TYPE "requite-cataloger"
+
+ALWAYS_ENABLED_STATISTIC(NumGlobalsCatalogedOnDemand, "globals cataloged on demand");
+
 namespace r {
 
 void Cataloger::tabulate_global(const r::Operation& operation, const r::Operation* attributes_operation)
@@ -32,4 +41,65 @@ void Cataloger::tabulate_global(const r::Operation& operation, const r::Operatio
     this->resolver.add_to_table(global);
 }
 
+void Cataloger::catalog(r::Global& global)
+{
+    global.catalog_state = r::CatalogState::CATALOGING;
+    this->resolver.enter(global);
+    const r::Operation& operation = *global.declaration;
+    const r::Expression* value_expression = nullptr;
+    r::Type type{};
+    if (operation.branches.size() == 3UZ)
+    {
+        const r::Expression& type_expression = operation.branches.at(1UZ);
+        type = this->resolver.resolve_type(type_expression);
+        value_expression = &operation.branches.back();
+    }
+    else if (operation.branches.size() == 2UZ)
+    {
+        const r::Expression& last_expression = operation.branches.back();
+        type = this->resolver.resolve_type(last_expression, true);
+        if (type.get_is_empty())
+        {
+            type = this->resolver.deduce_type(last_expression);
+            type.clear_literals();
+            value_expression = &last_expression;
+        }
+    }
+    else
+    {
+        throw std::runtime_error("invalid global.");
+    }
+    // globals are cataloged before type aliases, so the aliases named by the
+    // type are cataloged here first.
+    const r::Type* aliased_type = &type;
+    while (aliased_type->get_is_type_alias())
+    {
+        r::TypeAlias& type_alias = *std::get<r::TypeAlias*>(aliased_type->root);
+        if (type_alias.type.get_is_empty())
+        {
+            r::Cataloger type_alias_cataloger{};
+            type_alias_cataloger.catalog(type_alias);
+        }
+        aliased_type = &type_alias.type;
+    }
+    type.resolve_type_alias();
+    global.type = type;
+    if (value_expression != nullptr)
+    {
+        global.value = this->resolver.try_get_constant(*value_expression, global.type);
+        if (!global.value.has_value())
+        {
+            throw std::runtime_error("global value must be a compile-time constant.");
+        }
+    }
+    global.catalog_state = r::CatalogState::CATALOGED;
+}
+
+void Cataloger::catalog_on_demand(r::Global& global)
+{
+    assert(global.catalog_state == r::CatalogState::TABULATED);
+    ++NumGlobalsCatalogedOnDemand;
+    this->catalog(global);
+}
+
 }
\ No newline at end of file
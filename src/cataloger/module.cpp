@@ -4,6 +4,11 @@
 
 #include <cataloger/cataloger.hpp>
 #include <module/module.hpp>
+#include <binary.hpp>
+#include <object.hpp>
+#include <procedure.hpp>
+#include <global.hpp>
+#include <type_alias.hpp>
 #include <utility.hpp>
 
 #include <ranges>
@@ -55,19 +60,34 @@ void Cataloger::catalog(r::Module& module)
     {
         return;
     }
-    for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+    // a lazy catalog leaves procedures, objects and globals to be cataloged
+    // when the resolver or builder first needs them.
+    const bool is_lazy = module.binary->lazy_catalog;
+    if (!is_lazy)
     {
-        r::Procedure& procedure = *procedure_ptr.get();
-        this->catalog(procedure);
-    }
-    for (std::unique_ptr<r::Global>& global_ptr : module.globals)
-    {
-        r::Global& global = *global_ptr.get();
-    }
-    for (std::unique_ptr<r::Object>& object_ptr : module.objects)
-    {
-        r::Object& object = *object_ptr.get();
-        this->catalog(object);
+        for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+        {
+            r::Procedure& procedure = *procedure_ptr.get();
+            this->catalog(procedure);
+        }
+        for (std::unique_ptr<r::Global>& global_ptr : module.globals)
+        {
+            r::Global& global = *global_ptr.get();
+            if (global.catalog_state != r::CatalogState::TABULATED)
+            { // already cataloged on demand for a type or constant.
+                continue;
+            }
+            this->catalog(global);
+        }
+        for (std::unique_ptr<r::Object>& object_ptr : module.objects)
+        {
+            r::Object& object = *object_ptr.get();
+            if (object.catalog_state != r::CatalogState::TABULATED)
+            { // already cataloged on demand by an earlier property.
+                continue;
+            }
+            this->catalog(object);
+        }
     }
     for (std::unique_ptr<r::ObjectExtension>& object_extension_ptr : module.object_extensions)
     {
@@ -76,6 +96,10 @@ void Cataloger::catalog(r::Module& module)
     for (std::unique_ptr<r::TypeAlias>& type_alias_ptr : module.type_aliases)
     {
         r::TypeAlias& type_alias = *type_alias_ptr.get();
+        if (!type_alias.type.get_is_empty())
+        { // already cataloged for the type of a global.
+            continue;
+        }
         this->catalog(type_alias);
     }
 }
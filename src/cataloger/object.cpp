@@ -7,10 +7,19 @@
 #include <module/module.hpp>
 #include <utility.hpp>
 #include <object.hpp>
+#include <property.hpp>
+#include <binary.hpp>
+
+#include <llvm/ADT/Statistic.h>
 
 #include <memory>
 #include <cassert>
 #include <ranges>
+#include <stdexcept>
+
+#define DEBUG_TYPE "requite-cataloger"
+
+ALWAYS_ENABLED_STATISTIC(NumObjectsCatalogedOnDemand, "objects cataloged on demand");
 
 namespace r {
 
@@ -82,11 +91,13 @@ void Cataloger::tabulate_object(const r::Operation& operation, const r::Operatio
 void Cataloger::catalog(r::Object& object)
 {
     this->resolver.enter(object);
+    object.catalog_state = r::CatalogState::CATALOGING;
     for (std::unique_ptr<r::Property>& property_ptr : object.properties)
     {
         r::Property& property = *property_ptr.get();
         this->catalog(property);
     }
+    this->check_valid(object);
     const r::Operation* packed_attribute = object.attributes.try_get_attribute(r::Opcode::PACKED);
     if (packed_attribute != nullptr)
     {
@@ -98,7 +109,61 @@ void Cataloger::catalog(r::Object& object)
     {
         object.is_packed = false;
     }
+    const r::Operation* reorder_properties_attribute = object.attributes.try_get_attribute(r::Opcode::REORDER_PROPERTIES);
+    if (reorder_properties_attribute != nullptr)
+    {
+        assert(reorder_properties_attribute->opcode == r::Opcode::REORDER_PROPERTIES);
+        assert(reorder_properties_attribute->branches.empty());
+        if (object.is_packed)
+        {
+            throw std::runtime_error("packed object can not reorder properties.");
+        }
+        object.reorders_properties = true;
+    }
+    else
+    {
+        // packed objects have no padding to remove.
+        object.reorders_properties =
+            !object.is_packed &&
+            object.module->binary->reorder_properties;
+    }
+    object.catalog_state = r::CatalogState::CATALOGED;
     this->resolver.clear();
 }
 
+void Cataloger::check_valid(const r::Object& object)
+{
+    for (const std::unique_ptr<r::Property>& property_ptr : object.properties)
+    {
+        assert(property_ptr.get() != nullptr);
+        const r::Property& property = *property_ptr.get();
+        if (!property.type.get_is_object())
+        {
+            continue;
+        }
+        const r::Object* property_object_ptr = std::get<r::Object*>(property.type.root);
+        assert(property_object_ptr != nullptr);
+        const r::Object& property_object = *property_object_ptr;
+        assert(property_object.module != nullptr);
+        if (property_object.module == object.module)
+        {
+            if (property_object.module_symbol_i > object.module_symbol_i)
+            {
+                throw std::runtime_error("property object must be defined higher in source file.");
+            }
+        }
+        else if (!object.module->import_set.contains(property_object.module->mangled_name))
+        {
+            throw std::runtime_error("property object from other module must be imported.");
+        }
+    }
+}
+
+void Cataloger::catalog_on_demand(r::Object& object)
+{
+    assert(object.catalog_state == r::CatalogState::TABULATED);
+    ++NumObjectsCatalogedOnDemand;
+    this->catalog(object);
+}
+
 }
\ No newline at end of file
@@ -6,9 +6,18 @@
 #include <operation.hpp>
 #include <procedure.hpp>
 #include <binary.hpp>
+#include <module/module.hpp>
+#include <object.hpp>
+#include <type_context.hpp>
+
+#include <llvm/ADT/Statistic.h>
 
 #include <cassert>
 
+#define DEBUG_TYPE "requite-cataloger"
+
+ALWAYS_ENABLED_STATISTIC(NumProceduresCatalogedOnDemand, "procedures cataloged on demand");
+
 namespace r {
 
 void Cataloger::tabulate_procedure(const r::Operation& operation, const r::Operation* attributes_operation)
@@ -54,10 +63,12 @@ void Cataloger::catalog(r::Procedure& procedure)
 {
     this->resolver.enter(procedure);
 
+    procedure.catalog_state = r::CatalogState::CATALOGING;
     procedure.body_start_i = 0UZ;
 
     if (procedure.get_is_default())
     {
+        procedure.catalog_state = r::CatalogState::CATALOGED;
         return;
     }
     if (
@@ -71,13 +82,32 @@ void Cataloger::catalog(r::Procedure& procedure)
     this->catalog_user_mangled_name(procedure);
     this->catalog_calling_convention(procedure);
     this->catalog_variadic_arguments(procedure);
+    this->catalog_analyze_throughput(procedure);
     this->catalog_return_type(procedure);
     this->catalog_arguments(procedure);
     this->check_valid(procedure);
 
+    procedure.catalog_state = r::CatalogState::CATALOGED;
     this->resolver.clear();
 }
 
+void Cataloger::catalog_on_demand(r::Procedure& procedure)
+{
+    assert(procedure.catalog_state == r::CatalogState::TABULATED);
+    ++NumProceduresCatalogedOnDemand;
+    this->catalog(procedure);
+    procedure.return_type.resolve_type_alias();
+    for (r::ProcedureArgument& argument : procedure.arguments)
+    {
+        argument.type.resolve_type_alias();
+        argument.interned_type = &procedure.module->binary->type_context.intern(argument.type);
+    }
+    if (procedure.object != nullptr)
+    { // constructors initialize the properties of their object.
+        this->resolver.ensure_cataloged(*procedure.object);
+    }
+}
+
 void Cataloger::catalog_calling_convention(r::Procedure& procedure)
 {
     if (procedure.attributes.attribute_span.empty())
@@ -113,6 +143,22 @@ void Cataloger::catalog_variadic_arguments(r::Procedure& procedure)
     procedure.has_variadic_arguments = true;
 }
 
+void Cataloger::catalog_analyze_throughput(r::Procedure& procedure)
+{
+    if (procedure.attributes.attribute_span.empty())
+    {
+        return;
+    }
+    const r::Operation* analyze_throughput_attribute = procedure.attributes.try_get_attribute(r::Opcode::ANALYZE_THROUGHPUT);
+    if (analyze_throughput_attribute == nullptr)
+    {
+        return;
+    }
+    assert(analyze_throughput_attribute->opcode == r::Opcode::ANALYZE_THROUGHPUT);
+    assert(analyze_throughput_attribute->branches.empty());
+    procedure.analyze_throughput = true;
+}
+
 void Cataloger::catalog_user_mangled_name(r::Procedure& procedure)
 {
     if (procedure.category == r::ProcedureCategory::ENTRY_POINT)
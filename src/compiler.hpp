@@ -5,12 +5,28 @@
 #pragma once
 
 #include <build_command.hpp>
+#include <phase_timer.hpp>
 
 namespace r {
 
+struct Binary;
+
 struct Compiler final
 {
-    void build(const r::BuildCommand& build_command);
+    // the time spent in each phase of the last build.
+    r::PhaseTimer phase_timer{};
+
+    // returns the exit code of the entry point in run mode, otherwise 0.
+    int build(const r::BuildCommand& build_command);
+
+private:
+    void finish_build(const r::BuildCommand& build_command);
+
+    // run.cpp
+    int run(r::Binary& binary);
+
+    // link.cpp
+    void link(r::Binary& binary, const r::BuildCommand& build_command);
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <type.hpp>
+
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/APSInt.h>
+
+#include <variant>
+
+namespace r {
+
+// a value known at compile time. integers have the bit depth and signedness
+// of the type, and floating points have its semantics.
+struct Constant final
+{
+    r::Type type{};
+    std::variant<llvm::APSInt, llvm::APFloat, bool> value{};
+};
+
+}
@@ -6,7 +6,10 @@
 
 #include <type.hpp>
 #include <attributes.hpp>
+#include <catalog_state.hpp>
+#include <constant.hpp>
 
+#include <optional>
 #include <string_view>
 
 namespace r {
@@ -31,6 +34,10 @@ struct Global final
     r::Module* module = nullptr;
     std::size_t value_i = 0UZ;
     r::Attributes attributes{};
+    r::CatalogState catalog_state = r::CatalogState::TABULATED;
+    // globals are not emitted. their values are evaluated when cataloged and
+    // used as constants wherever they are named.
+    std::optional<r::Constant> value{};
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// The kind of intermediate representation file written for each module.
+enum class IrOutput
+{
+    // no intermediate file is written.
+    NONE,
+    // human readable LLVM assembly (.ll).
+    TEXT,
+    // LLVM bitcode (.bc).
+    BITCODE
+};
+
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <compiler.hpp>
+#include <binary.hpp>
+#include <module/module.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/Program.h>
+
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace r {
+
+void Compiler::link(r::Binary& binary, const r::BuildCommand& build_command)
+{
+    assert(build_command.link_output != r::LinkOutput::NONE);
+    // the compiler driver knows where the C runtime and libc live on this
+    // system, so it is used instead of invoking a linker directly.
+    llvm::ErrorOr<std::string> linker_path = llvm::sys::findProgramByName(build_command.linker);
+    if (!linker_path)
+    {
+        throw std::runtime_error(std::format("linker not found: {}", build_command.linker));
+    }
+    llvm::SmallVector<std::string> arguments{};
+    arguments.reserve(binary.modules.size() + build_command.link_libraries.size() + 5UZ);
+    arguments.push_back(*linker_path);
+    if (build_command.link_output == r::LinkOutput::SHARED_LIBRARY)
+    {
+        arguments.push_back("-shared");
+    }
+    if (binary.profile_mode == r::ProfileMode::INSTRUMENT)
+    { // links the profile runtime that writes the raw profile on exit.
+        arguments.push_back("-fprofile-generate");
+    }
+    for (const r::Module& module : binary.modules)
+    {
+        for (const std::filesystem::path& obj_path : module.obj_paths)
+        {
+            arguments.push_back(obj_path.string());
+        }
+    }
+    arguments.push_back("-o");
+    arguments.push_back(build_command.output_path.string());
+    for (const std::string& library : build_command.link_libraries)
+    {
+        arguments.push_back(std::format("-l{}", library));
+    }
+    llvm::SmallVector<llvm::StringRef> argument_refs(arguments.begin(), arguments.end());
+    std::string error_message{};
+    const int result =
+        llvm::sys::ExecuteAndWait(
+            *linker_path,
+            argument_refs,
+            std::nullopt,
+            {},
+            0U,
+            0U,
+            &error_message
+        );
+    if (result != 0)
+    {
+        if (error_message.empty())
+        {
+            throw std::runtime_error("linking failed.");
+        }
+        throw std::runtime_error(error_message);
+    }
+}
+
+}
@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// What the emitted object files are linked into.
+enum class LinkOutput
+{
+    // object files are left for the user to link.
+    NONE,
+    EXECUTABLE,
+    SHARED_LIBRARY
+};
+
+}
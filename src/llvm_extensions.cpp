@@ -21,6 +21,7 @@ void initialize_llvm()
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
+    llvm::InitializeNativeTargetDisassembler();
 }
 
 const llvm::fltSemantics& get_float_semantics(const r::FloatingPoint& floating_point)
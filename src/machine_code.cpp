@@ -0,0 +1,268 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <machine_code.hpp>
+#include <binary.hpp>
+#include <module/module.hpp>
+#include <procedure.hpp>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Mangler.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Triple.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace r {
+
+void MachineCode::initialize(const r::Binary& binary)
+{
+    assert(binary.llvm_target != nullptr);
+    const std::string& triple = binary.llvm_target_triple;
+    this->llvm_target = binary.llvm_target;
+    this->llvm_register_info.reset(this->llvm_target->createMCRegInfo(triple));
+    llvm::MCTargetOptions llvm_target_options;
+    this->llvm_asm_info.reset(
+        this->llvm_target->createMCAsmInfo(
+            *this->llvm_register_info.get(),
+            triple,
+            llvm_target_options
+        )
+    );
+    this->llvm_subtarget_info.reset(
+        this->llvm_target->createMCSubtargetInfo(
+            triple,
+            binary.target_cpu,
+            binary.target_features
+        )
+    );
+    this->llvm_instr_info.reset(this->llvm_target->createMCInstrInfo());
+    if (
+        this->llvm_register_info == nullptr ||
+        this->llvm_asm_info == nullptr ||
+        this->llvm_subtarget_info == nullptr ||
+        this->llvm_instr_info == nullptr
+    )
+    {
+        throw std::runtime_error("target does not support machine code analysis.");
+    }
+    this->llvm_context =
+        std::make_unique<llvm::MCContext>(
+            llvm::Triple(triple),
+            this->llvm_asm_info.get(),
+            this->llvm_register_info.get(),
+            this->llvm_subtarget_info.get()
+        );
+    this->llvm_disassembler.reset(
+        this->llvm_target->createMCDisassembler(
+            *this->llvm_subtarget_info.get(),
+            *this->llvm_context.get()
+        )
+    );
+    if (this->llvm_disassembler == nullptr)
+    {
+        throw std::runtime_error("target has no disassembler.");
+    }
+    this->llvm_instr_analysis.reset(
+        this->llvm_target->createMCInstrAnalysis(
+            this->llvm_instr_info.get()
+        )
+    );
+    this->llvm_inst_printer.reset(
+        this->llvm_target->createMCInstPrinter(
+            llvm::Triple(triple),
+            this->llvm_asm_info->getAssemblerDialect(),
+            *this->llvm_asm_info.get(),
+            *this->llvm_instr_info.get(),
+            *this->llvm_register_info.get()
+        )
+    );
+    if (this->llvm_inst_printer == nullptr)
+    {
+        throw std::runtime_error("target has no instruction printer.");
+    }
+}
+
+void MachineCode::disassemble(const std::filesystem::path& obj_path)
+{
+    assert(this->llvm_disassembler != nullptr);
+    llvm::Expected<llvm::object::OwningBinary<llvm::object::ObjectFile>> expected_object_file =
+        llvm::object::ObjectFile::createObjectFile(obj_path.string());
+    if (!expected_object_file)
+    {
+        throw std::runtime_error(llvm::toString(expected_object_file.takeError()));
+    }
+    const llvm::object::ObjectFile& object_file = *expected_object_file->getBinary();
+
+    struct FunctionSymbol final
+    {
+        std::string name{};
+        llvm::object::SectionRef section{};
+        std::uint64_t address = 0UZ;
+    };
+    llvm::SmallVector<FunctionSymbol> function_symbols{};
+    for (const llvm::object::SymbolRef& symbol : object_file.symbols())
+    {
+        llvm::Expected<llvm::object::SymbolRef::Type> expected_type = symbol.getType();
+        if (!expected_type)
+        {
+            llvm::consumeError(expected_type.takeError());
+            continue;
+        }
+        if (*expected_type != llvm::object::SymbolRef::ST_Function)
+        {
+            continue;
+        }
+        llvm::Expected<llvm::StringRef> expected_name = symbol.getName();
+        llvm::Expected<std::uint64_t> expected_address = symbol.getAddress();
+        llvm::Expected<llvm::object::section_iterator> expected_section = symbol.getSection();
+        if (!expected_name || !expected_address || !expected_section)
+        {
+            llvm::consumeError(expected_name.takeError());
+            llvm::consumeError(expected_address.takeError());
+            llvm::consumeError(expected_section.takeError());
+            continue;
+        }
+        if (*expected_section == object_file.section_end())
+        { // undefined external functions.
+            continue;
+        }
+        FunctionSymbol& function_symbol = function_symbols.emplace_back();
+        function_symbol.name = expected_name->str();
+        function_symbol.section = **expected_section;
+        function_symbol.address = *expected_address;
+    }
+    // symbol sizes are not available for every object format, so each
+    // function is assumed to end where the next one in its section starts.
+    std::ranges::sort(
+        function_symbols,
+        [](const FunctionSymbol& lhs, const FunctionSymbol& rhs)
+        {
+            if (lhs.section.getIndex() != rhs.section.getIndex())
+            {
+                return lhs.section.getIndex() < rhs.section.getIndex();
+            }
+            return lhs.address < rhs.address;
+        }
+    );
+    for (std::size_t symbol_i = 0UZ; symbol_i < function_symbols.size(); symbol_i++)
+    {
+        const FunctionSymbol& function_symbol = function_symbols[symbol_i];
+        const llvm::object::SectionRef& section = function_symbol.section;
+        llvm::Expected<llvm::StringRef> expected_contents = section.getContents();
+        if (!expected_contents)
+        {
+            throw std::runtime_error(llvm::toString(expected_contents.takeError()));
+        }
+        const std::uint64_t section_address = section.getAddress();
+        std::uint64_t end_address = section_address + section.getSize();
+        if (
+            symbol_i + 1UZ < function_symbols.size() &&
+            function_symbols[symbol_i + 1UZ].section == section
+        )
+        {
+            end_address = function_symbols[symbol_i + 1UZ].address;
+        }
+        r::MachineProcedure& machine_procedure = this->procedures.emplace_back();
+        machine_procedure.symbol_name = function_symbol.name;
+        machine_procedure.address = function_symbol.address;
+        machine_procedure.size = end_address - function_symbol.address;
+        llvm::ArrayRef<std::uint8_t> bytes =
+            llvm::arrayRefFromStringRef(*expected_contents).slice(
+                function_symbol.address - section_address,
+                machine_procedure.size
+            );
+        std::uint64_t offset = 0UZ;
+        while (offset < bytes.size())
+        {
+            llvm::MCInst llvm_inst;
+            std::uint64_t instruction_size = 0UZ;
+            const llvm::MCDisassembler::DecodeStatus status =
+                this->llvm_disassembler->getInstruction(
+                    llvm_inst,
+                    instruction_size,
+                    bytes.slice(offset),
+                    function_symbol.address + offset,
+                    llvm::nulls()
+                );
+            if (status == llvm::MCDisassembler::Fail)
+            { // skip padding and data that is not an instruction.
+                offset += std::max<std::uint64_t>(instruction_size, 1UZ);
+                continue;
+            }
+            r::MachineInstruction& machine_instruction = machine_procedure.instructions.emplace_back();
+            machine_instruction.llvm_inst = llvm_inst;
+            machine_instruction.address = function_symbol.address + offset;
+            machine_instruction.size = instruction_size;
+            offset += instruction_size;
+        }
+    }
+}
+
+void MachineCode::map_procedures(r::Module& module)
+{
+    assert(module.binary != nullptr);
+    assert(module.binary->llvm_data_layout != nullptr);
+    const llvm::DataLayout& llvm_data_layout = *module.binary->llvm_data_layout.get();
+    // optimization may have deleted the llvm functions, so procedures are
+    // found by the names recorded when their functions were created.
+    llvm::StringMap<r::Procedure*> symbol_table{};
+    for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+    {
+        r::Procedure& procedure = *procedure_ptr.get();
+        if (procedure.symbol_name.empty())
+        {
+            continue;
+        }
+        llvm::SmallString<64UZ> symbol_name{};
+        llvm::Mangler::getNameWithPrefix(
+            symbol_name,
+            procedure.symbol_name,
+            llvm_data_layout
+        );
+        symbol_table[symbol_name] = &procedure;
+    }
+    for (r::MachineProcedure& machine_procedure : this->procedures)
+    {
+        auto symbol_iter = symbol_table.find(machine_procedure.symbol_name);
+        if (symbol_iter != symbol_table.end())
+        {
+            machine_procedure.procedure = symbol_iter->second;
+        }
+    }
+}
+
+std::string MachineCode::get_instruction_text(const r::MachineInstruction& instruction) const
+{
+    assert(this->llvm_inst_printer != nullptr);
+    std::string text{};
+    llvm::raw_string_ostream ostream(text);
+    this->llvm_inst_printer->printInst(
+        &instruction.llvm_inst,
+        instruction.address,
+        "",
+        *this->llvm_subtarget_info.get(),
+        ostream
+    );
+    ostream.flush();
+    // printed instructions start with a tab.
+    const std::size_t first_i = text.find_first_not_of(" \t");
+    if (first_i == std::string::npos)
+    {
+        return std::string();
+    }
+    return text.substr(first_i);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCDisassembler/MCDisassembler.h>
+#include <llvm/MC/MCInst.h>
+#include <llvm/MC/MCInstrAnalysis.h>
+#include <llvm/MC/MCInstPrinter.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/TargetRegistry.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace r {
+
+struct Binary;
+struct Module;
+struct Procedure;
+
+struct MachineInstruction final
+{
+    llvm::MCInst llvm_inst{};
+    std::uint64_t address = 0UZ;
+    std::uint64_t size = 0UZ;
+};
+
+struct MachineProcedure final
+{
+    std::string symbol_name{};
+    std::uint64_t address = 0UZ;
+    std::uint64_t size = 0UZ;
+    llvm::SmallVector<r::MachineInstruction> instructions{};
+    // the requite procedure this machine code was generated from, if any.
+    r::Procedure* procedure = nullptr;
+};
+
+// The disassembled functions of an emitted object file. Used to report on
+// the machine code that was generated for each procedure.
+struct MachineCode final
+{
+    const llvm::Target* llvm_target = nullptr;
+    std::unique_ptr<llvm::MCRegisterInfo> llvm_register_info{};
+    std::unique_ptr<llvm::MCAsmInfo> llvm_asm_info{};
+    std::unique_ptr<llvm::MCSubtargetInfo> llvm_subtarget_info{};
+    std::unique_ptr<llvm::MCInstrInfo> llvm_instr_info{};
+    std::unique_ptr<llvm::MCContext> llvm_context{};
+    std::unique_ptr<llvm::MCDisassembler> llvm_disassembler{};
+    std::unique_ptr<llvm::MCInstrAnalysis> llvm_instr_analysis{};
+    std::unique_ptr<llvm::MCInstPrinter> llvm_inst_printer{};
+    llvm::SmallVector<r::MachineProcedure> procedures{};
+
+    void initialize(const r::Binary& binary);
+    void disassemble(const std::filesystem::path& obj_path);
+    void map_procedures(r::Module& module);
+    std::string get_instruction_text(const r::MachineInstruction& instruction) const;
+};
+
+}
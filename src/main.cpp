@@ -16,6 +16,5 @@ int main()
             "r_primitives.requite",
             "test.requite"
         };
-    compiler.build(build_command);
-    return 0;
+    return compiler.build(build_command);
 }
\ No newline at end of file
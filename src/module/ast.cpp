@@ -4,11 +4,17 @@
 
 #include <module/module.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <cstddef>
 #include <utility>
 #include <cassert>
 #include <optional>
 
+#define DEBUG_TYPE "requite-parser"
+
+ALWAYS_ENABLED_STATISTIC(NumExpressionsParsed, "expressions parsed");
+
 namespace r {
 
 void Module::parse_ast()
@@ -465,37 +471,36 @@ void Module::parse_ast()
             throw std::runtime_error("expression must terminate in closing character.");
         }
 
-        r::Operation parse_expression_args(char terminator, r::Opcode opcode)
-        {
-            r::Operation operation;
-            operation.opcode = opcode;
-            return this->parse_expression_args(terminator, operation);
-        }
-
         r::Operation parse_s_expression()
         {
             assert(this->get_cur_char() == '[');
+            const std::size_t source_i = this->char_i;
             this->char_i++;
             this->skip_comments_and_spaces();
             r::Opcode opcode = this->parse_opcode();
+            r::Operation operation;
+            operation.opcode = opcode;
+            operation.source_i = source_i;
             if (opcode == r::Opcode::IF)
             {
                 r::Operation condition;
                 condition.opcode = r::Opcode::CONDITION;
+                condition.source_i = source_i;
                 condition.branches.push_back(
                     std::move(
-                        this->parse_expression_args(']', opcode)
+                        this->parse_expression_args(']', operation)
                     )
                 );
                 return condition;
             }
-            return this->parse_expression_args(']', opcode);
+            return this->parse_expression_args(']', operation);
         }
 
-        r::Operation parse_unary_expression(r::Opcode opcode)
+        r::Operation parse_unary_expression(r::Opcode opcode, std::size_t source_i)
         {
             r::Operation operation;
             operation.opcode = opcode;
+            operation.source_i = source_i;
             this->skip_comments_and_spaces();
             operation.branches.push_back(this->parse_expression());
             return operation;
@@ -503,32 +508,34 @@ void Module::parse_ast()
 
         r::Expression parse_inner_expression()
         {
+            ++NumExpressionsParsed;
             this->skip_comments_and_spaces();
             assert(!this->get_is_at_end());
+            const std::size_t source_i = this->char_i;
             switch (this->get_cur_char())
             {
                 case '[':
                     return this->parse_s_expression();
                 case '+':
                     this->char_i++;
-                    return this->parse_unary_expression(r::Opcode::PLUS);
+                    return this->parse_unary_expression(r::Opcode::PLUS, source_i);
                 case '-':
                     this->char_i++;
-                    return this->parse_unary_expression(r::Opcode::MINUS);
+                    return this->parse_unary_expression(r::Opcode::MINUS, source_i);
                 case '!':
                     if (this->get_next_char() == '!')
                     {
                         this->char_i += 2UZ;
-                        return this->parse_unary_expression(r::Opcode::BANG_BANG);
+                        return this->parse_unary_expression(r::Opcode::BANG_BANG, source_i);
                     }
                     this->char_i++;
-                    return this->parse_unary_expression(r::Opcode::BANG);
+                    return this->parse_unary_expression(r::Opcode::BANG, source_i);
                 case '*':
                     this->char_i++;
-                    return this->parse_unary_expression(r::Opcode::STAR);
+                    return this->parse_unary_expression(r::Opcode::STAR, source_i);
                 case '#':
                     this->char_i++;
-                    return this->parse_unary_expression(r::Opcode::HASH);
+                    return this->parse_unary_expression(r::Opcode::HASH, source_i);
                 case '\"':
                     return this->parse_string();
                 case '\'':
@@ -551,6 +558,8 @@ void Module::parse_ast()
 
         r::Expression parse_expression()
         {
+            this->skip_comments_and_spaces();
+            const std::size_t source_i = this->char_i;
             r::Expression expression = this->parse_inner_expression();
             this->skip_comments_and_spaces();
             while(!this->get_is_at_end())
@@ -573,8 +582,10 @@ void Module::parse_ast()
                                 return;
                             }
                         }
+                        ++NumExpressionsParsed;
                         r::Operation binary_operation;
                         binary_operation.opcode = opcode;
+                        binary_operation.source_i = source_i;
                         binary_operation.branches.push_back(
                             std::move(
                                 expression
@@ -590,8 +601,10 @@ void Module::parse_ast()
                 const auto parse_m_expression =
                     [&](char terminator, r::Opcode opcode)
                     {
+                        ++NumExpressionsParsed;
                         r::Operation operation;
                         operation.opcode = opcode;
+                        operation.source_i = source_i;
                         operation.branches.emplace_back(std::move(expression));
                         this->parse_expression_args(terminator, operation);
                         expression = std::move(operation);
@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: MIT
 
 #include <module/module.hpp>
+#include <binary.hpp>
+#include <object_cache.hpp>
+#include <optimization_level.hpp>
 
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Support/FileSystem.h>
@@ -11,46 +14,202 @@
 #include <llvm/Support/CodeGen.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
-#include <llvm/TargetParser/Host.h>
 #include "llvm/IR/LegacyPassManager.h"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <exception>
 #include <filesystem>
 #include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 namespace r {
 
-void Module::compile_intermediate_file()
+namespace {
+
+bool get_has_definitions(const llvm::Module& llvm_module)
+{
+    return
+        std::ranges::any_of(
+            llvm_module,
+            [](const llvm::Function& llvm_function)
+            {
+                return !llvm_function.isDeclaration();
+            }
+        );
+}
+
+void compile_object(llvm::Module& llvm_module, const r::Binary& binary, const std::filesystem::path& obj_path)
 {
-    auto target_triple = llvm::sys::getDefaultTargetTriple();
-    this->llvm_module->setTargetTriple(target_triple);
+    const std::string& target_triple = binary.llvm_target_triple;
+    llvm_module.setTargetTriple(target_triple);
     std::string error;
     auto target = llvm::TargetRegistry::lookupTarget(target_triple, error);
     if (target == nullptr)
     {
         throw std::runtime_error(error);
     }
-    const char* cpu = "generic";
-    const char* features = "";
+    const std::string& cpu = binary.target_cpu;
+    const std::string& features = binary.target_features;
     llvm::TargetOptions options;
-    auto machine = target->createTargetMachine(target_triple, cpu, features, options, llvm::Reloc::PIC_);
+    const auto reloc_model = llvm::Reloc::PIC_;
+    const llvm::CodeGenOptLevel codegen_opt_level = r::to_llvm_codegen_opt_level(binary.optimization_level);
+    std::unique_ptr<llvm::TargetMachine> machine(
+        target->createTargetMachine(target_triple, cpu, features, options, reloc_model, std::nullopt, codegen_opt_level)
+    );
     auto data_layout = machine->createDataLayout();
-    this->llvm_module->setDataLayout(data_layout);
-    this->llvm_module->setTargetTriple(target_triple);
+    llvm_module.setDataLayout(data_layout);
+    llvm_module.setTargetTriple(target_triple);
+    const auto file_type = llvm::CodeGenFileType::ObjectFile;
+    const r::ObjectCache& object_cache = binary.object_cache;
+    std::string cache_key{};
+    if (object_cache.get_is_enabled())
+    {
+        const std::string codegen_options =
+            std::format(
+                "cpu={};features={};reloc={};opt={};file={}",
+                cpu,
+                features,
+                static_cast<int>(reloc_model),
+                static_cast<int>(machine->getOptLevel()),
+                static_cast<int>(file_type)
+            );
+        cache_key = object_cache.get_key(llvm_module, codegen_options);
+        if (object_cache.try_fetch(cache_key, obj_path))
+        {
+            return;
+        }
+    }
+    // the old output may be a hard link into the cache from an earlier build,
+    // so it must be unlinked instead of truncated even without a cache.
+    std::filesystem::remove(obj_path);
     std::error_code error_code;
-    std::filesystem::path obj_path = this->path.replace_filename(std::format("{}.obj", this->mangled_name));
     llvm::raw_fd_ostream ofile(obj_path.c_str(), error_code, llvm::sys::fs::OF_None);
     if (error_code)
     {
         throw std::runtime_error(error_code.message());
     }
     llvm::legacy::PassManager pass;
-    const auto file_type = llvm::CodeGenFileType::ObjectFile;
     if (machine->addPassesToEmitFile(pass, ofile, nullptr, file_type))
     {
         throw std::runtime_error("the target machine can not emit a file of this type.");
     }
-    pass.run(*this->llvm_module.get());
-    ofile.flush();
+    pass.run(llvm_module);
+    ofile.close();
+    if (object_cache.get_is_enabled())
+    {
+        object_cache.store(cache_key, obj_path);
+    }
 }
 
-}
\ No newline at end of file
+}
+
+void Module::compile_intermediate_file()
+{
+    this->obj_paths.clear();
+    if (!r::get_has_definitions(*this->llvm_module.get()))
+    {
+        return;
+    }
+    const unsigned codegen_units = this->binary->codegen_units;
+    if (codegen_units <= 1U)
+    {
+        std::filesystem::path& obj_path =
+            this->obj_paths.emplace_back(
+                std::filesystem::path(this->path).replace_filename(
+                    std::format("{}.obj", this->mangled_name)
+                )
+            );
+        r::compile_object(*this->llvm_module.get(), *this->binary, obj_path);
+        return;
+    }
+    this->llvm_module->setTargetTriple(this->binary->llvm_target_triple);
+    this->llvm_module->setDataLayout(*this->binary->llvm_data_layout.get());
+    // every unit is compiled in its own context because an llvm::LLVMContext
+    // can not be used by more than one thread. the units are moved between
+    // contexts as bitcode. internal symbols stay internal and in the unit of
+    // their users. otherwise they are made hidden externals, which collide
+    // between modules at link time.
+    llvm::SmallVector<llvm::SmallString<0>> unit_bitcodes{};
+    llvm::SplitModule(
+        *this->llvm_module.get(),
+        codegen_units,
+        [&](std::unique_ptr<llvm::Module> llvm_unit)
+        {
+            if (!r::get_has_definitions(*llvm_unit.get()))
+            {
+                return;
+            }
+            llvm::raw_svector_ostream ostream(unit_bitcodes.emplace_back());
+            llvm::WriteBitcodeToFile(*llvm_unit.get(), ostream);
+        },
+        true
+    );
+    for (std::size_t unit_i = 0UZ; unit_i < unit_bitcodes.size(); unit_i++)
+    {
+        this->obj_paths.push_back(
+            std::filesystem::path(this->path).replace_filename(
+                std::format("{}.{}.obj", this->mangled_name, unit_i)
+            )
+        );
+    }
+    std::mutex error_mutex;
+    std::string error{};
+    llvm::ThreadPool thread_pool(llvm::hardware_concurrency(codegen_units));
+    for (std::size_t unit_i = 0UZ; unit_i < unit_bitcodes.size(); unit_i++)
+    {
+        thread_pool.async(
+            [&, unit_i]()
+            {
+                // errors can not leave the thread, so the first one is kept
+                // and thrown after every unit is finished.
+                try
+                {
+                    llvm::LLVMContext llvm_context;
+                    llvm::Expected<std::unique_ptr<llvm::Module>> expected_unit =
+                        llvm::parseBitcodeFile(
+                            llvm::MemoryBufferRef(
+                                unit_bitcodes[unit_i].str(),
+                                this->mangled_name
+                            ),
+                            llvm_context
+                        );
+                    if (!expected_unit)
+                    {
+                        throw std::runtime_error(llvm::toString(expected_unit.takeError()));
+                    }
+                    r::compile_object(**expected_unit, *this->binary, this->obj_paths[unit_i]);
+                }
+                catch (const std::exception& exception)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (error.empty())
+                    {
+                        error = exception.what();
+                    }
+                }
+            }
+        );
+    }
+    thread_pool.wait();
+    if (!error.empty())
+    {
+        throw std::runtime_error(error);
+    }
+}
+
+}
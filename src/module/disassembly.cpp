@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <module/module.hpp>
+#include <binary.hpp>
+#include <machine_code.hpp>
+#include <procedure.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+namespace r {
+
+namespace {
+
+std::string get_listing_name(const r::MachineProcedure& machine_procedure)
+{
+    // code no procedure recorded a name for, such as functions outlined by
+    // passes. its symbol is listed next to it.
+    if (machine_procedure.procedure == nullptr)
+    {
+        return "unknown";
+    }
+    return machine_procedure.procedure->get_qualified_name();
+}
+
+}
+
+void Module::write_disassembly_listing()
+{
+    assert(this->binary != nullptr);
+    assert(!this->obj_paths.empty());
+    r::MachineCode machine_code;
+    machine_code.initialize(*this->binary);
+    for (const std::filesystem::path& obj_path : this->obj_paths)
+    {
+        machine_code.disassemble(obj_path);
+    }
+    machine_code.map_procedures(*this);
+    std::filesystem::path listing_path =
+        std::filesystem::path(this->path).replace_filename(
+            std::format("{}.disassembly.txt", this->mangled_name)
+        );
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(listing_path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+
+    // the summary ranks procedures by size so code bloat stands out.
+    llvm::SmallVector<const r::MachineProcedure*> ranked_procedures{};
+    std::uint64_t total_size = 0UZ;
+    std::uint64_t total_instruction_count = 0UZ;
+    for (const r::MachineProcedure& machine_procedure : machine_code.procedures)
+    {
+        ranked_procedures.push_back(&machine_procedure);
+        total_size += machine_procedure.size;
+        total_instruction_count += machine_procedure.instructions.size();
+    }
+    std::ranges::stable_sort(
+        ranked_procedures,
+        [](const r::MachineProcedure* lhs, const r::MachineProcedure* rhs)
+        {
+            return lhs->size > rhs->size;
+        }
+    );
+    ofile << std::format(
+        "disassembly of module {} (cpu: {})\n\n",
+        this->mangled_name,
+        this->binary->target_cpu
+    );
+    ofile << std::format(
+        "{:>10} {:>12} {:>7}  {}\n",
+        "bytes",
+        "instructions",
+        "share",
+        "procedure"
+    );
+    for (const r::MachineProcedure* machine_procedure : ranked_procedures)
+    {
+        const double share =
+            total_size == 0UZ ?
+                0.0 :
+                100.0 * static_cast<double>(machine_procedure->size) / static_cast<double>(total_size);
+        ofile << std::format(
+            "{:>10} {:>12} {:>6.1f}%  {} ({})\n",
+            machine_procedure->size,
+            machine_procedure->instructions.size(),
+            share,
+            r::get_listing_name(*machine_procedure),
+            machine_procedure->symbol_name
+        );
+    }
+    ofile << std::format(
+        "{:>10} {:>12}          total\n",
+        total_size,
+        total_instruction_count
+    );
+
+    for (const r::MachineProcedure& machine_procedure : machine_code.procedures)
+    {
+        ofile << std::format(
+            "\n{} ({}): {} bytes, {} instructions\n",
+            r::get_listing_name(machine_procedure),
+            machine_procedure.symbol_name,
+            machine_procedure.size,
+            machine_procedure.instructions.size()
+        );
+        for (const r::MachineInstruction& instruction : machine_procedure.instructions)
+        {
+            ofile << std::format(
+                "  {:8x}: {:>2}  {}\n",
+                instruction.address,
+                instruction.size,
+                machine_code.get_instruction_text(instruction)
+            );
+        }
+    }
+    ofile.flush();
+}
+
+}
@@ -37,7 +37,7 @@ void Module::determine_imports()
             r::Module& module = this->binary->get_module(module_name);
             assert(!this->import_set.contains(module_name));
             this->import_vector.push_back(&module);
-            this->import_set.emplace(module_name);
+            this->import_set.insert(module_name);
         }
     }
 }
@@ -57,7 +57,7 @@ void Module::expand_imports()
         {
             if (!this->import_set.contains(import_import_ptr->mangled_name))
             {
-                this->import_set.emplace(import_import_ptr->mangled_name);
+                this->import_set.insert(import_import_ptr->mangled_name);
                 this->import_vector.push_back(import_import_ptr);
             }
         }
@@ -6,15 +6,21 @@
 #include <binary.hpp>
 #include <procedure.hpp>
 #include <builder/builder.hpp>
-#include <file_io.hpp>
+#include <utility.hpp>
 
 #include <llvm/IR/Module.h>
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/BinaryFormat/Dwarf.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include <memory>
 #include <string>
 #include <filesystem>
 #include <format>
+#include <stdexcept>
 
 namespace r {
 
@@ -22,15 +28,86 @@ void Module::initialize_llvm_module()
 {
     this->llvm_module = std::make_unique<llvm::Module>(this->mangled_name.c_str(), *this->binary->llvm_context.get());
     this->llvm_module->setSourceFileName(this->path.c_str());
+    if (!this->binary->debug_info)
+    {
+        return;
+    }
+    this->llvm_module->addModuleFlag(
+        llvm::Module::Warning,
+        "Debug Info Version",
+        llvm::DEBUG_METADATA_VERSION
+    );
+    this->llvm_module->addModuleFlag(
+        llvm::Module::Warning,
+        "Dwarf Version",
+        5U
+    );
+    this->llvm_di_builder = std::make_unique<llvm::DIBuilder>(*this->llvm_module.get());
+    const std::filesystem::path absolute_path = std::filesystem::absolute(this->path);
+    this->llvm_di_file =
+        this->llvm_di_builder->createFile(
+            absolute_path.filename().string(),
+            absolute_path.parent_path().string()
+        );
+    // there is no dwarf language code for requite, so it is described as c.
+    this->llvm_di_compile_unit =
+        this->llvm_di_builder->createCompileUnit(
+            llvm::dwarf::DW_LANG_C,
+            this->llvm_di_file,
+            "requite",
+            this->binary->optimization_level != r::OptimizationLevel::O0,
+            "",
+            0U
+        );
 }
 
-void Module::write_ir_file()
+void Module::finalize_debug_info()
 {
-    std::string ir_source;
-    llvm::raw_string_ostream raw_string_ostream(ir_source);
-    this->llvm_module->print(raw_string_ostream, nullptr);
-    std::filesystem::path ir_file_path = this->path.replace_filename(std::format("{}.ir", this->mangled_name));
-    r::write_file_text(ir_file_path, ir_source);
+    if (this->llvm_di_builder == nullptr)
+    {
+        return;
+    }
+    this->llvm_di_builder->finalize();
+}
+
+void Module::write_ir_file(r::IrOutput ir_output)
+{
+    if (ir_output == r::IrOutput::NONE)
+    {
+        return;
+    }
+    // stream directly to the file so the module is never printed into memory.
+    const bool is_text = ir_output == r::IrOutput::TEXT;
+    std::filesystem::path ir_file_path =
+        std::filesystem::path(this->path).replace_filename(
+            std::format(
+                "{}.{}",
+                this->mangled_name,
+                is_text ? "ll" : "bc"
+            )
+        );
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(
+        ir_file_path.c_str(),
+        error_code,
+        is_text ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None
+    );
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    switch (ir_output)
+    {
+        case r::IrOutput::TEXT:
+            this->llvm_module->print(ofile, nullptr);
+            break;
+        case r::IrOutput::BITCODE:
+            llvm::WriteBitcodeToFile(*this->llvm_module.get(), ofile);
+            break;
+        default:
+            r::unreachable();
+    }
+    ofile.flush();
 }
 
 }
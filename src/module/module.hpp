@@ -12,14 +12,21 @@
 #include <procedure.hpp>
 #include <global.hpp>
 #include <type_alias.hpp>
+#include <ir_output.hpp>
+#include <optimization_remark.hpp>
+#include <source_location.hpp>
 
 #include "llvm/IR/Module.h"
 #include <llvm/IR/Value.h>
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringRef.h>
 
 #include <filesystem>
 #include <string>
 #include <memory>
-#include <set>
 
 namespace r {
 
@@ -36,10 +43,13 @@ struct Module final
 {
     std::filesystem::path path{};
     std::string source{};
+    // the offset of the first character of each line in source.
+    llvm::SmallVector<std::size_t> line_offsets{};
     std::string mangled_name{};
     std::size_t first_declaration_i = 0UZ;
     llvm::SmallVector<r::Module*> import_vector{};
-    std::set<std::string_view> import_set{};
+    // the names of every module imported, directly or through other imports.
+    llvm::DenseSet<llvm::StringRef> import_set{};
     bool is_expanded = false;
     llvm::SmallVector<r::Operation> ast{};
     r::Binary* binary = nullptr;
@@ -50,6 +60,11 @@ struct Module final
     llvm::SmallVector<std::unique_ptr<r::ProcedureGroup>> procedure_groups{};
     llvm::SmallVector<std::unique_ptr<r::TypeAlias>> type_aliases{};
     r::SymbolTable table{};
+    // the symbols unqualified names at module scope resolve to, with the
+    // module table shadowing the binary table. built once tabulation is done,
+    // so lookups take one probe instead of one per table.
+    llvm::DenseMap<llvm::StringRef, r::Symbol> visible_symbols{};
+    bool has_visible_symbols = false;
 
     // the index of this module in Binary::ordered_modules;
     std::size_t module_i = 0UZ;
@@ -58,9 +73,19 @@ struct Module final
     std::size_t last_blocking_module_i = 0UZ;
 
     std::unique_ptr<llvm::Module> llvm_module{};
+    // only created when debug info is enabled.
+    std::unique_ptr<llvm::DIBuilder> llvm_di_builder{};
+    llvm::DICompileUnit* llvm_di_compile_unit = nullptr;
+    llvm::DIFile* llvm_di_file = nullptr;
+    // collected by optimize when optimization remarks are enabled.
+    llvm::SmallVector<r::OptimizationRemark> optimization_remarks{};
+    // the object files written by compile_intermediate_file. there is one per
+    // codegen unit, and none if the module has no code.
+    llvm::SmallVector<std::filesystem::path> obj_paths{};
 
     // source.cpp
     void read_source(const std::filesystem::path& path);
+    r::SourceLocation get_source_location(std::size_t source_i) const;
 
     // ast.cpp
     void parse_ast();
@@ -75,16 +100,30 @@ struct Module final
 
     // ir.cpp
     void initialize_llvm_module();
+    void finalize_debug_info();
     void generate_ir();
-    void write_ir_file();
+    void write_ir_file(r::IrOutput ir_output);
 
     // resolve_type_aliases.cpp
     void resolve_type_aliases();
 
+    // optimize.cpp
+    void optimize();
+
+    // remarks.cpp
+    void write_optimization_remarks();
+
     // compile.cpp
     void compile_intermediate_file();
 
+    // disassembly.cpp
+    void write_disassembly_listing();
+
+    // throughput.cpp
+    void write_throughput_report();
+
     // symbols.cpp
+    void index_visible_symbols();
     r::Procedure& add_procedure();
     r::Global& add_global();
     r::Object& add_object();
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <module/module.hpp>
+#include <binary.hpp>
+#include <optimization_level.hpp>
+#include <profile_mode.hpp>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Support/PGOOptions.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Transforms/IPO/HotColdSplitting.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace r {
+
+namespace {
+
+// records the remarks emitted by passes while a module is optimized.
+struct OptimizationRemarkHandler final : llvm::DiagnosticHandler
+{
+    r::Module& module;
+    llvm::StringMap<r::Procedure*> procedure_map{};
+
+    OptimizationRemarkHandler(r::Module& module)
+        : module(module)
+    {
+        // remarks can outlive the functions they are about when those are
+        // inlined and deleted, so procedures are found by the names they
+        // recorded before the pipeline runs.
+        for (std::unique_ptr<r::Procedure>& procedure_ptr : module.procedures)
+        {
+            r::Procedure& procedure = *procedure_ptr.get();
+            if (!procedure.symbol_name.empty())
+            {
+                this->procedure_map[procedure.symbol_name] = &procedure;
+            }
+        }
+    }
+
+    bool isAnalysisRemarkEnabled(llvm::StringRef) const override
+    {
+        return true;
+    }
+
+    bool isMissedOptRemarkEnabled(llvm::StringRef) const override
+    {
+        return true;
+    }
+
+    bool isPassedOptRemarkEnabled(llvm::StringRef) const override
+    {
+        return true;
+    }
+
+    bool isAnyRemarkEnabled() const override
+    {
+        return true;
+    }
+
+    bool handleDiagnostics(const llvm::DiagnosticInfo& llvm_diagnostic) override
+    {
+        const auto* llvm_remark = llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&llvm_diagnostic);
+        if (llvm_remark == nullptr)
+        { // errors and warnings are left to the default handler.
+            return false;
+        }
+        r::OptimizationRemark& remark = this->module.optimization_remarks.emplace_back();
+        if (llvm_remark->isPassed())
+        {
+            remark.kind = r::OptimizationRemarkKind::PASSED;
+        }
+        else if (llvm_remark->isMissed())
+        {
+            remark.kind = r::OptimizationRemarkKind::MISSED;
+        }
+        else
+        {
+            remark.kind = r::OptimizationRemarkKind::ANALYSIS;
+        }
+        remark.pass_name = llvm_remark->getPassName().str();
+        remark.remark_name = llvm_remark->getRemarkName().str();
+        const llvm::Function& llvm_function = llvm_remark->getFunction();
+        if (llvm_function.hasName())
+        {
+            remark.function_name = llvm_function.getName().str();
+            auto procedure_iter = this->procedure_map.find(remark.function_name);
+            if (procedure_iter != this->procedure_map.end())
+            {
+                remark.procedure = procedure_iter->second;
+            }
+        }
+        else
+        { // unnamed functions can not be told apart.
+            remark.function_name = "unknown";
+        }
+        if (llvm_remark->isLocationAvailable())
+        {
+            const llvm::DiagnosticLocation llvm_location = llvm_remark->getLocation();
+            remark.location.line = llvm_location.getLine();
+            remark.location.column = llvm_location.getColumn();
+        }
+        remark.message = llvm_remark->getMsg();
+        return true;
+    }
+};
+
+}
+
+void Module::optimize()
+{
+    assert(this->binary != nullptr);
+    assert(this->llvm_module != nullptr);
+    const r::OptimizationLevel optimization_level = this->binary->optimization_level;
+    const r::ProfileMode profile_mode = this->binary->profile_mode;
+    if (
+        optimization_level == r::OptimizationLevel::O0 &&
+        profile_mode != r::ProfileMode::INSTRUMENT
+    )
+    { // profile use has no effect without optimization.
+        return;
+    }
+    this->llvm_module->setTargetTriple(this->binary->llvm_target_triple);
+    this->llvm_module->setDataLayout(*this->binary->llvm_data_layout.get());
+
+    std::optional<llvm::PGOOptions> llvm_pgo_options{};
+    if (profile_mode == r::ProfileMode::INSTRUMENT)
+    {
+        // an empty path lets the profile runtime choose default_%m.profraw.
+        llvm_pgo_options =
+            llvm::PGOOptions(
+                this->binary->profile_path.string(),
+                "",
+                "",
+                "",
+                llvm::vfs::getRealFileSystem(),
+                llvm::PGOOptions::IRInstr
+            );
+    }
+    else if (profile_mode == r::ProfileMode::USE)
+    {
+        if (!std::filesystem::exists(this->binary->profile_path))
+        {
+            throw std::runtime_error("profile data file does not exist.");
+        }
+        // attaches branch weights and function entry counts to the generated
+        // procedures, which the inliner and hot/cold splitting then consume.
+        llvm_pgo_options =
+            llvm::PGOOptions(
+                this->binary->profile_path.string(),
+                "",
+                "",
+                "",
+                llvm::vfs::getRealFileSystem(),
+                llvm::PGOOptions::IRUse
+            );
+    }
+
+    llvm::LoopAnalysisManager llvm_loop_analysis_manager;
+    llvm::FunctionAnalysisManager llvm_function_analysis_manager;
+    llvm::CGSCCAnalysisManager llvm_cgscc_analysis_manager;
+    llvm::ModuleAnalysisManager llvm_module_analysis_manager;
+    llvm::PipelineTuningOptions llvm_tuning_options;
+    llvm::PassBuilder llvm_pass_builder(
+        this->binary->llvm_target_machine,
+        llvm_tuning_options,
+        llvm_pgo_options
+    );
+    if (profile_mode == r::ProfileMode::USE)
+    {
+        llvm_pass_builder.registerOptimizerLastEPCallback(
+            [](llvm::ModulePassManager& llvm_module_pass_manager, llvm::OptimizationLevel)
+            {
+                llvm_module_pass_manager.addPass(llvm::HotColdSplittingPass());
+            }
+        );
+    }
+    llvm_pass_builder.registerModuleAnalyses(llvm_module_analysis_manager);
+    llvm_pass_builder.registerCGSCCAnalyses(llvm_cgscc_analysis_manager);
+    llvm_pass_builder.registerFunctionAnalyses(llvm_function_analysis_manager);
+    llvm_pass_builder.registerLoopAnalyses(llvm_loop_analysis_manager);
+    llvm_pass_builder.crossRegisterProxies(
+        llvm_loop_analysis_manager,
+        llvm_function_analysis_manager,
+        llvm_cgscc_analysis_manager,
+        llvm_module_analysis_manager
+    );
+    const llvm::OptimizationLevel llvm_optimization_level = r::to_llvm_optimization_level(optimization_level);
+    llvm::ModulePassManager llvm_module_pass_manager =
+        (optimization_level == r::OptimizationLevel::O0) ?
+        llvm_pass_builder.buildO0DefaultPipeline(llvm_optimization_level) :
+        llvm_pass_builder.buildPerModuleDefaultPipeline(llvm_optimization_level);
+    if (!this->binary->optimization_remarks)
+    {
+        llvm_module_pass_manager.run(*this->llvm_module.get(), llvm_module_analysis_manager);
+    }
+    else
+    {
+        // the context is shared by every module, so the handler is only
+        // swapped in while this module is optimized.
+        llvm::LLVMContext& llvm_context = this->llvm_module->getContext();
+        std::unique_ptr<llvm::DiagnosticHandler> llvm_previous_handler = llvm_context.getDiagnosticHandler();
+        llvm_context.setDiagnosticHandler(std::make_unique<r::OptimizationRemarkHandler>(*this));
+        llvm_module_pass_manager.run(*this->llvm_module.get(), llvm_module_analysis_manager);
+        llvm_context.setDiagnosticHandler(std::move(llvm_previous_handler));
+    }
+    // inlined procedures may have been deleted, so none are kept.
+    for (std::unique_ptr<r::Procedure>& procedure_ptr : this->procedures)
+    {
+        procedure_ptr->llvm_function = nullptr;
+    }
+}
+
+}
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <module/module.hpp>
+#include <optimization_remark.hpp>
+#include <optimization_remark_kind.hpp>
+#include <procedure.hpp>
+
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace r {
+
+namespace {
+
+std::string get_remark_procedure_name(const r::OptimizationRemark& remark)
+{
+    if (remark.procedure == nullptr)
+    {
+        return remark.function_name;
+    }
+    return remark.procedure->get_qualified_name();
+}
+
+}
+
+void Module::write_optimization_remarks()
+{
+    const std::filesystem::path json_path =
+        std::filesystem::path(this->path).replace_filename(
+            std::format("{}.remarks.json", this->mangled_name)
+        );
+    std::error_code error_code;
+    llvm::raw_fd_ostream json_file(json_path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    llvm::json::OStream json(json_file, 2U);
+    json.array(
+        [&]()
+        {
+            for (const r::OptimizationRemark& remark : this->optimization_remarks)
+            {
+                json.object(
+                    [&]()
+                    {
+                        json.attribute("kind", llvm::StringRef(r::to_string(remark.kind)));
+                        json.attribute("pass", remark.pass_name);
+                        json.attribute("name", remark.remark_name);
+                        json.attribute("module", this->mangled_name);
+                        json.attribute("function", remark.function_name);
+                        if (remark.procedure != nullptr)
+                        {
+                            json.attribute("procedure", remark.procedure->get_qualified_name());
+                        }
+                        if (remark.location.line != 0U)
+                        {
+                            json.attribute("line", remark.location.line);
+                            json.attribute("column", remark.location.column);
+                        }
+                        json.attribute("message", remark.message);
+                    }
+                );
+            }
+        }
+    );
+    json_file << '\n';
+    json_file.flush();
+
+    const std::filesystem::path summary_path =
+        std::filesystem::path(this->path).replace_filename(
+            std::format("{}.remarks.txt", this->mangled_name)
+        );
+    llvm::raw_fd_ostream summary_file(summary_path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    std::size_t passed_count = 0UZ;
+    std::size_t missed_count = 0UZ;
+    std::size_t analysis_count = 0UZ;
+    llvm::StringMap<std::size_t> passed_pass_counts{};
+    // missed optimizations and the analysis explaining them are grouped by
+    // function, in the order the functions were optimized.
+    llvm::MapVector<llvm::StringRef, llvm::SmallVector<const r::OptimizationRemark*>> missed_remarks{};
+    for (const r::OptimizationRemark& remark : this->optimization_remarks)
+    {
+        switch (remark.kind)
+        {
+            case r::OptimizationRemarkKind::PASSED:
+                passed_count++;
+                passed_pass_counts[remark.pass_name]++;
+                continue;
+            case r::OptimizationRemarkKind::MISSED:
+                missed_count++;
+                break;
+            case r::OptimizationRemarkKind::ANALYSIS:
+                analysis_count++;
+                break;
+        }
+        missed_remarks[remark.function_name].push_back(&remark);
+    }
+    summary_file << std::format(
+        "optimization remarks for module {}\n  passed: {}, missed: {}, analysis: {}\n",
+        this->mangled_name,
+        passed_count,
+        missed_count,
+        analysis_count
+    );
+    if (!passed_pass_counts.empty())
+    {
+        llvm::SmallVector<std::pair<std::string_view, std::size_t>> ranked_passes{};
+        for (const auto& pass_count : passed_pass_counts)
+        {
+            ranked_passes.emplace_back(pass_count.getKey(), pass_count.getValue());
+        }
+        std::ranges::sort(
+            ranked_passes,
+            [](const auto& lhs, const auto& rhs)
+            {
+                if (lhs.second != rhs.second)
+                {
+                    return lhs.second > rhs.second;
+                }
+                return lhs.first < rhs.first;
+            }
+        );
+        summary_file << "\napplied optimizations by pass:\n";
+        for (const auto& [pass_name, count] : ranked_passes)
+        {
+            summary_file << std::format("  {:<24} {}\n", pass_name, count);
+        }
+    }
+    if (!missed_remarks.empty())
+    {
+        summary_file << "\nmissed optimizations:\n";
+        for (const auto& [function_name, remarks] : missed_remarks)
+        {
+            summary_file << std::format(
+                "  {} ({})\n",
+                r::get_remark_procedure_name(*remarks.front()),
+                function_name.str()
+            );
+            for (const r::OptimizationRemark* remark : remarks)
+            {
+                std::string location = "?";
+                if (remark->location.line != 0U)
+                {
+                    location = std::format("{}:{}", remark->location.line, remark->location.column);
+                }
+                summary_file << std::format(
+                    "    {} {} {}/{}: {}\n",
+                    location,
+                    r::to_string(remark->kind),
+                    remark->pass_name,
+                    remark->remark_name,
+                    remark->message
+                );
+            }
+        }
+    }
+    summary_file.flush();
+}
+
+}
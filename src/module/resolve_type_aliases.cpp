@@ -8,6 +8,8 @@
 #include <global.hpp>
 #include <object.hpp>
 #include <property.hpp>
+#include <binary.hpp>
+#include <type_context.hpp>
 
 #include <cassert>
 
@@ -22,6 +24,7 @@ void Module::resolve_type_aliases()
         for (r::ProcedureArgument& argument : procedure.arguments)
         {
             argument.type.resolve_type_alias();
+            argument.interned_type = &this->binary->type_context.intern(argument.type);
         }
     }
     for (std::unique_ptr<r::Global>& global_ptr : this->globals)
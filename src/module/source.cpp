@@ -5,7 +5,9 @@
 #include <module/module.hpp>
 #include <file_io.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 
 namespace r {
 
@@ -15,6 +17,27 @@ void Module::read_source(const std::filesystem::path& path)
     assert(this->path.empty());
     this->path = path;
     this->source = r::read_file_text(path);
+    this->line_offsets.clear();
+    this->line_offsets.push_back(0UZ);
+    for (std::size_t char_i = 0UZ; char_i < this->source.size(); char_i++)
+    {
+        if (this->source[char_i] == '\n')
+        {
+            this->line_offsets.push_back(char_i + 1UZ);
+        }
+    }
+}
+
+r::SourceLocation Module::get_source_location(std::size_t source_i) const
+{
+    assert(!this->line_offsets.empty());
+    auto line_iter = std::ranges::upper_bound(this->line_offsets, source_i);
+    assert(line_iter != this->line_offsets.begin());
+    line_iter--;
+    r::SourceLocation location;
+    location.line = static_cast<unsigned>(line_iter - this->line_offsets.begin()) + 1U;
+    location.column = static_cast<unsigned>(source_i - *line_iter) + 1U;
+    return location;
 }
 
 }
\ No newline at end of file
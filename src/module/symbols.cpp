@@ -11,11 +11,28 @@
 #include <builder/builder.hpp>
 #include <utility.hpp>
 
+#include <cassert>
 #include <memory>
 #include <sstream>
 
 namespace r {
 
+void Module::index_visible_symbols()
+{
+    assert(this->binary != nullptr);
+    this->visible_symbols.clear();
+    this->visible_symbols.reserve(this->table.table.size() + this->binary->table.table.size());
+    for (const auto& [name, symbol] : this->table.table)
+    {
+        this->visible_symbols.try_emplace(name, symbol);
+    }
+    for (const auto& [name, symbol] : this->binary->table.table)
+    { // names already taken by the module shadow the binary.
+        this->visible_symbols.try_emplace(name, symbol);
+    }
+    this->has_visible_symbols = true;
+}
+
 r::Procedure& Module::add_procedure()
 {
     std::unique_ptr<r::Procedure>& procedure_ptr = this->procedures.emplace_back();
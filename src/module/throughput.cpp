@@ -0,0 +1,448 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <module/module.hpp>
+#include <binary.hpp>
+#include <machine_code.hpp>
+#include <procedure.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/bit.h>
+#include <llvm/MC/MCSchedule.h>
+#include <llvm/MCA/Context.h>
+#include <llvm/MCA/CustomBehaviour.h>
+#include <llvm/MCA/HWEventListener.h>
+#include <llvm/MCA/InstrBuilder.h>
+#include <llvm/MCA/Instruction.h>
+#include <llvm/MCA/Pipeline.h>
+#include <llvm/MCA/SourceMgr.h>
+#include <llvm/MCA/Support.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace r {
+
+namespace {
+
+// the number of times each region is simulated.
+constexpr unsigned THROUGHPUT_ITERATIONS = 100U;
+
+struct ThroughputRegion final
+{
+    std::size_t begin_i = 0UZ;
+    // one past the last instruction in the region.
+    std::size_t end_i = 0UZ;
+    bool is_loop = false;
+};
+
+// collects the statistics of a simulated region from pipeline events.
+struct ThroughputListener final : llvm::mca::HWEventListener
+{
+    const llvm::MCSchedModel& llvm_sched_model;
+    llvm::SmallVector<std::uint64_t> resource_masks{};
+    llvm::DenseMap<std::uint64_t, unsigned> resource_mask_indices{};
+    llvm::SmallVector<double> resource_cycles{};
+    llvm::SmallVector<std::uint64_t> resource_pressure_cycles{};
+    std::uint64_t retired_instruction_count = 0UZ;
+    std::uint64_t register_dependency_cycles = 0UZ;
+    std::uint64_t memory_dependency_cycles = 0UZ;
+
+    ThroughputListener(const llvm::MCSchedModel& llvm_sched_model)
+        : llvm_sched_model(llvm_sched_model)
+        , resource_masks(llvm_sched_model.getNumProcResourceKinds(), 0UZ)
+        , resource_cycles(llvm_sched_model.getNumProcResourceKinds(), 0.0)
+        , resource_pressure_cycles(llvm_sched_model.getNumProcResourceKinds(), 0UZ)
+    {
+        llvm::mca::computeProcResourceMasks(this->llvm_sched_model, this->resource_masks);
+        // index 0 is the invalid resource.
+        for (unsigned resource_i = 1U; resource_i < this->resource_masks.size(); resource_i++)
+        {
+            this->resource_mask_indices[this->resource_masks[resource_i]] = resource_i;
+        }
+    }
+
+    void onEvent(const llvm::mca::HWInstructionEvent& event) override
+    {
+        if (event.Type == llvm::mca::HWInstructionEvent::Retired)
+        {
+            this->retired_instruction_count++;
+            return;
+        }
+        if (event.Type != llvm::mca::HWInstructionEvent::Issued)
+        {
+            return;
+        }
+        const auto& issued_event = static_cast<const llvm::mca::HWInstructionIssuedEvent&>(event);
+        for (const auto& [resource_ref, cycles] : issued_event.UsedResources)
+        {
+            auto index_iter = this->resource_mask_indices.find(resource_ref.first);
+            if (index_iter == this->resource_mask_indices.end())
+            {
+                continue;
+            }
+            this->resource_cycles[index_iter->second] +=
+                static_cast<double>(cycles.getNumerator()) /
+                static_cast<double>(cycles.getDenominator());
+        }
+    }
+
+    void onEvent(const llvm::mca::HWPressureEvent& event) override
+    {
+        switch (event.Reason)
+        {
+            case llvm::mca::HWPressureEvent::RESOURCES:
+                for (unsigned resource_i = 1U; resource_i < this->resource_masks.size(); resource_i++)
+                {
+                    const std::uint64_t mask = this->resource_masks[resource_i];
+                    // only count units so groups do not hide the contended port.
+                    if (llvm::popcount(mask) == 1 && (event.ResourceMask & mask) != 0UZ)
+                    {
+                        this->resource_pressure_cycles[resource_i]++;
+                    }
+                }
+                break;
+            case llvm::mca::HWPressureEvent::REGISTER_DEPS:
+                this->register_dependency_cycles++;
+                break;
+            case llvm::mca::HWPressureEvent::MEMORY_DEPS:
+                this->memory_dependency_cycles++;
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+llvm::SmallVector<ThroughputRegion> get_throughput_regions(const r::MachineCode& machine_code, const r::MachineProcedure& machine_procedure)
+{
+    llvm::SmallVector<ThroughputRegion> regions{};
+    const llvm::SmallVector<r::MachineInstruction>& instructions = machine_procedure.instructions;
+    if (instructions.empty())
+    {
+        return regions;
+    }
+    if (machine_procedure.procedure != nullptr && machine_procedure.procedure->analyze_throughput)
+    {
+        regions.push_back(ThroughputRegion{0UZ, instructions.size(), false});
+        return regions;
+    }
+    if (machine_code.llvm_instr_analysis == nullptr)
+    {
+        return regions;
+    }
+    // a loop is a branch back to an earlier instruction of the same procedure.
+    llvm::SmallVector<ThroughputRegion> loops{};
+    for (std::size_t branch_i = 0UZ; branch_i < instructions.size(); branch_i++)
+    {
+        const r::MachineInstruction& branch = instructions[branch_i];
+        if (!machine_code.llvm_instr_analysis->isBranch(branch.llvm_inst))
+        {
+            continue;
+        }
+        std::uint64_t target_address = 0UZ;
+        if (
+            !machine_code.llvm_instr_analysis->evaluateBranch(
+                branch.llvm_inst,
+                branch.address,
+                branch.size,
+                target_address
+            )
+        )
+        {
+            continue;
+        }
+        if (target_address > branch.address || target_address < machine_procedure.address)
+        {
+            continue;
+        }
+        auto target_iter =
+            std::ranges::find_if(
+                instructions,
+                [&](const r::MachineInstruction& instruction)
+                {
+                    return instruction.address == target_address;
+                }
+            );
+        if (target_iter == instructions.end())
+        {
+            continue;
+        }
+        const std::size_t target_i = static_cast<std::size_t>(target_iter - instructions.begin());
+        loops.push_back(ThroughputRegion{target_i, branch_i + 1UZ, true});
+    }
+    // only innermost loops are reported; outer loops are dominated by them.
+    for (const ThroughputRegion& loop : loops)
+    {
+        const bool has_inner_loop =
+            std::ranges::any_of(
+                loops,
+                [&](const ThroughputRegion& other)
+                {
+                    return
+                        &other != &loop &&
+                        other.begin_i >= loop.begin_i &&
+                        other.end_i <= loop.end_i &&
+                        (other.begin_i != loop.begin_i || other.end_i != loop.end_i);
+                }
+            );
+        if (!has_inner_loop)
+        {
+            regions.push_back(loop);
+        }
+    }
+    return regions;
+}
+
+void write_throughput_region(
+    llvm::raw_ostream& ostream,
+    const r::MachineCode& machine_code,
+    const r::MachineProcedure& machine_procedure,
+    const ThroughputRegion& region
+)
+{
+    const llvm::MCSubtargetInfo& llvm_subtarget_info = *machine_code.llvm_subtarget_info.get();
+    const llvm::MCInstrInfo& llvm_instr_info = *machine_code.llvm_instr_info.get();
+    const llvm::MCSchedModel& llvm_sched_model = llvm_subtarget_info.getSchedModel();
+    const llvm::Target& llvm_target = *machine_code.llvm_target;
+
+    std::unique_ptr<llvm::mca::InstrumentManager> instrument_manager(
+        llvm_target.createInstrumentManager(llvm_subtarget_info, llvm_instr_info)
+    );
+    if (instrument_manager == nullptr)
+    {
+        instrument_manager = std::make_unique<llvm::mca::InstrumentManager>(llvm_subtarget_info, llvm_instr_info);
+    }
+    std::unique_ptr<llvm::mca::InstrPostProcess> instr_post_process(
+        llvm_target.createInstrPostProcess(llvm_subtarget_info, llvm_instr_info)
+    );
+    if (instr_post_process == nullptr)
+    {
+        instr_post_process = std::make_unique<llvm::mca::InstrPostProcess>(llvm_subtarget_info, llvm_instr_info);
+    }
+    llvm::mca::InstrBuilder instr_builder(
+        llvm_subtarget_info,
+        llvm_instr_info,
+        *machine_code.llvm_register_info.get(),
+        machine_code.llvm_instr_analysis.get(),
+        *instrument_manager.get()
+    );
+    llvm::SmallVector<std::unique_ptr<llvm::mca::Instruction>> mca_instructions{};
+    const llvm::SmallVector<llvm::mca::Instrument*> instruments{};
+    std::size_t skipped_instruction_count = 0UZ;
+    for (std::size_t instruction_i = region.begin_i; instruction_i < region.end_i; instruction_i++)
+    {
+        const llvm::MCInst& llvm_inst = machine_procedure.instructions[instruction_i].llvm_inst;
+        llvm::Expected<std::unique_ptr<llvm::mca::Instruction>> expected_instruction =
+            instr_builder.createInstruction(llvm_inst, instruments);
+        if (!expected_instruction)
+        { // instructions without scheduling information are left out.
+            llvm::consumeError(expected_instruction.takeError());
+            skipped_instruction_count++;
+            continue;
+        }
+        instr_post_process->postProcessInstruction(*expected_instruction, llvm_inst);
+        mca_instructions.push_back(std::move(*expected_instruction));
+    }
+    const std::uint64_t start_address = machine_procedure.instructions[region.begin_i].address;
+    const std::uint64_t end_address =
+        machine_procedure.instructions[region.end_i - 1UZ].address +
+        machine_procedure.instructions[region.end_i - 1UZ].size;
+    ostream << std::format(
+        "  {} 0x{:x}-0x{:x} ({} instructions)\n",
+        region.is_loop ? "innermost loop" : "marked region",
+        start_address,
+        end_address,
+        region.end_i - region.begin_i
+    );
+    if (mca_instructions.empty())
+    {
+        ostream << "    no instructions could be simulated.\n";
+        return;
+    }
+
+    llvm::mca::Context mca_context(*machine_code.llvm_register_info.get(), llvm_subtarget_info);
+    // the same options llvm-mca uses by default. zero sizes and widths are
+    // taken from the scheduling model of the subtarget, loads and stores are
+    // assumed not to alias, and calls are assumed to take 100 cycles.
+    const unsigned micro_op_queue_size = 0U;
+    const unsigned decoder_throughput = 0U;
+    const unsigned dispatch_width = 0U;
+    const unsigned register_file_size = 0U;
+    const unsigned load_queue_size = 0U;
+    const unsigned store_queue_size = 0U;
+    const bool assume_no_alias = true;
+    const unsigned call_latency = 100U;
+    const bool enable_bottleneck_analysis = true;
+    llvm::mca::PipelineOptions mca_pipeline_options(
+        micro_op_queue_size,
+        decoder_throughput,
+        dispatch_width,
+        register_file_size,
+        load_queue_size,
+        store_queue_size,
+        assume_no_alias,
+        call_latency,
+        enable_bottleneck_analysis
+    );
+    llvm::mca::CircularSourceMgr mca_source_manager(mca_instructions, THROUGHPUT_ITERATIONS);
+    std::unique_ptr<llvm::mca::CustomBehaviour> custom_behaviour(
+        llvm_target.createCustomBehaviour(llvm_subtarget_info, mca_source_manager, llvm_instr_info)
+    );
+    if (custom_behaviour == nullptr)
+    {
+        custom_behaviour = std::make_unique<llvm::mca::CustomBehaviour>(llvm_subtarget_info, mca_source_manager, llvm_instr_info);
+    }
+    std::unique_ptr<llvm::mca::Pipeline> mca_pipeline =
+        mca_context.createDefaultPipeline(
+            mca_pipeline_options,
+            mca_source_manager,
+            *custom_behaviour.get()
+        );
+    ThroughputListener listener(llvm_sched_model);
+    mca_pipeline->addEventListener(&listener);
+    llvm::Expected<unsigned> expected_cycles = mca_pipeline->run();
+    if (!expected_cycles)
+    {
+        ostream << std::format("    simulation failed: {}\n", llvm::toString(expected_cycles.takeError()));
+        return;
+    }
+    const double total_cycles = static_cast<double>(*expected_cycles);
+    const double iterations = static_cast<double>(THROUGHPUT_ITERATIONS);
+    if (skipped_instruction_count != 0UZ)
+    {
+        ostream << std::format("    instructions without scheduling information: {}\n", skipped_instruction_count);
+    }
+    ostream << std::format("    cycles per iteration: {:.2f}\n", total_cycles / iterations);
+    ostream << std::format("    instructions per cycle: {:.2f}\n", static_cast<double>(listener.retired_instruction_count) / total_cycles);
+    ostream << "    resource pressure per iteration:\n";
+    for (unsigned resource_i = 1U; resource_i < listener.resource_cycles.size(); resource_i++)
+    {
+        const double cycles = listener.resource_cycles[resource_i] / iterations;
+        if (cycles == 0.0)
+        {
+            continue;
+        }
+        ostream << std::format(
+            "      {:<24} {:.2f}\n",
+            llvm_sched_model.getProcResource(resource_i)->Name,
+            cycles
+        );
+    }
+    // the bottleneck is whatever most often stopped instructions from being
+    // dispatched during the simulation.
+    unsigned bottleneck_resource_i = 0U;
+    for (unsigned resource_i = 1U; resource_i < listener.resource_pressure_cycles.size(); resource_i++)
+    {
+        if (listener.resource_pressure_cycles[resource_i] > listener.resource_pressure_cycles[bottleneck_resource_i])
+        {
+            bottleneck_resource_i = resource_i;
+        }
+    }
+    const std::uint64_t resource_pressure_cycles = listener.resource_pressure_cycles[bottleneck_resource_i];
+    const std::uint64_t max_pressure_cycles =
+        std::max({
+            resource_pressure_cycles,
+            listener.register_dependency_cycles,
+            listener.memory_dependency_cycles
+        });
+    if (max_pressure_cycles == 0UZ)
+    {
+        ostream << "    bottleneck: none\n";
+    }
+    else if (max_pressure_cycles == resource_pressure_cycles)
+    {
+        ostream << std::format(
+            "    bottleneck: {} ({:.1f}% of cycles)\n",
+            llvm_sched_model.getProcResource(bottleneck_resource_i)->Name,
+            100.0 * static_cast<double>(resource_pressure_cycles) / total_cycles
+        );
+    }
+    else if (max_pressure_cycles == listener.register_dependency_cycles)
+    {
+        ostream << std::format(
+            "    bottleneck: register dependencies ({:.1f}% of cycles)\n",
+            100.0 * static_cast<double>(listener.register_dependency_cycles) / total_cycles
+        );
+    }
+    else
+    {
+        ostream << std::format(
+            "    bottleneck: memory dependencies ({:.1f}% of cycles)\n",
+            100.0 * static_cast<double>(listener.memory_dependency_cycles) / total_cycles
+        );
+    }
+}
+
+}
+
+void Module::write_throughput_report()
+{
+    assert(this->binary != nullptr);
+    assert(!this->obj_paths.empty());
+    r::MachineCode machine_code;
+    machine_code.initialize(*this->binary);
+    if (!machine_code.llvm_subtarget_info->getSchedModel().hasInstrSchedModel())
+    {
+        throw std::runtime_error("the selected cpu has no scheduling model for throughput analysis.");
+    }
+    for (const std::filesystem::path& obj_path : this->obj_paths)
+    {
+        machine_code.disassemble(obj_path);
+    }
+    machine_code.map_procedures(*this);
+    std::filesystem::path report_path =
+        std::filesystem::path(this->path).replace_filename(
+            std::format("{}.throughput.txt", this->mangled_name)
+        );
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(report_path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    ofile << std::format(
+        "throughput report for module {} (cpu: {})\n",
+        this->mangled_name,
+        this->binary->target_cpu
+    );
+    for (const r::MachineProcedure& machine_procedure : machine_code.procedures)
+    {
+        llvm::SmallVector<ThroughputRegion> regions =
+            r::get_throughput_regions(
+                machine_code,
+                machine_procedure
+            );
+        if (regions.empty())
+        {
+            continue;
+        }
+        ofile << std::format(
+            "\n{} ({})\n",
+            machine_procedure.procedure != nullptr ?
+                machine_procedure.procedure->get_qualified_name() :
+                machine_procedure.symbol_name,
+            machine_procedure.symbol_name
+        );
+        for (const ThroughputRegion& region : regions)
+        {
+            r::write_throughput_region(ofile, machine_code, machine_procedure, region);
+        }
+    }
+    ofile.flush();
+}
+
+}
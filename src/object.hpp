@@ -9,12 +9,15 @@
 #include <attributes.hpp>
 #include <property.hpp>
 #include <procedure_group.hpp>
+#include <object_layout.hpp>
+#include <catalog_state.hpp>
 
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/ADT/SmallVector.h>
 
 #include <string_view>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 namespace r {
@@ -30,6 +33,8 @@ struct Object final
     std::string_view name{};
     std::size_t module_symbol_i = 0UZ;
     bool is_packed = false;
+    // properties are laid out by alignment instead of declaration order.
+    bool reorders_properties = false;
     r::ExportGroup* export_group = nullptr;
     r::ProcedureGroup constructor_group{};
     r::Procedure* destructor = nullptr;
@@ -39,6 +44,11 @@ struct Object final
     llvm::SmallVector<std::unique_ptr<r::Property>> properties{};
     std::unordered_map<std::string_view, r::Property*> property_table{};
     r::Attributes attributes{};
+    r::CatalogState catalog_state = r::CatalogState::TABULATED;
+
+    // computed by the resolver the first time the object is measured.
+    std::optional<r::ObjectLayout> layout{};
+    bool is_laying_out = false;
 
     llvm::StructType* llvm_struct_type = nullptr;
 
@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <object_cache.hpp>
+
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SHA256.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace r {
+
+namespace {
+
+// no store takes this long, so older temporary files were abandoned.
+constexpr std::chrono::hours STALE_TEMP_FILE_AGE{1};
+
+}
+
+bool ObjectCache::get_is_enabled() const noexcept
+{
+    return !this->directory.empty();
+}
+
+std::string ObjectCache::get_key(const llvm::Module& llvm_module, std::string_view codegen_options) const
+{
+    // bitcode is much cheaper to produce than textual IR, and it also records
+    // the llvm version, triple and data layout of the module.
+    llvm::SmallVector<char, 0UZ> bitcode{};
+    llvm::raw_svector_ostream bitcode_ostream(bitcode);
+    llvm::WriteBitcodeToFile(llvm_module, bitcode_ostream);
+    llvm::SHA256 hasher;
+    hasher.update(llvm::StringRef(bitcode.data(), bitcode.size()));
+    hasher.update(llvm_module.getTargetTriple());
+    hasher.update(llvm::StringRef(codegen_options.data(), codegen_options.size()));
+    std::array<std::uint8_t, 32UZ> digest = hasher.final();
+    return llvm::toHex(digest, true);
+}
+
+bool ObjectCache::try_fetch(std::string_view key, const std::filesystem::path& obj_path) const
+{
+    assert(this->get_is_enabled());
+    const std::filesystem::path entry_path = this->get_entry_path(key);
+    std::error_code error_code;
+    std::filesystem::remove(obj_path, error_code);
+    // another process may evict the entry at any time, so every failure below
+    // is treated as a cache miss.
+    std::filesystem::create_hard_link(entry_path, obj_path, error_code);
+    if (error_code)
+    {
+        error_code.clear();
+        std::filesystem::copy_file(entry_path, obj_path, error_code);
+        if (error_code)
+        {
+            return false;
+        }
+    }
+    // refresh the entry so it is the last to be evicted.
+    std::filesystem::last_write_time(
+        entry_path,
+        std::filesystem::file_time_type::clock::now(),
+        error_code
+    );
+    return true;
+}
+
+void ObjectCache::store(std::string_view key, const std::filesystem::path& obj_path) const
+{
+    assert(this->get_is_enabled());
+    std::error_code error_code;
+    std::filesystem::create_directories(this->directory, error_code);
+    if (error_code)
+    {
+        return;
+    }
+    // copy into a uniquely named file first so that readers never see a
+    // partially written entry, then publish it with an atomic rename.
+    llvm::SmallString<256UZ> temp_path{};
+    int temp_fd = -1;
+    const std::filesystem::path temp_model = this->directory / std::format("{}-%%%%%%%%.tmp", key);
+    if (llvm::sys::fs::createUniqueFile(temp_model.c_str(), temp_fd, temp_path))
+    {
+        return;
+    }
+    llvm::sys::fs::closeFile(temp_fd);
+    const std::filesystem::path temp_file_path(temp_path.str().str());
+    std::filesystem::copy_file(
+        obj_path,
+        temp_file_path,
+        std::filesystem::copy_options::overwrite_existing,
+        error_code
+    );
+    if (!error_code)
+    {
+        std::filesystem::rename(temp_file_path, this->get_entry_path(key), error_code);
+    }
+    if (error_code)
+    {
+        std::filesystem::remove(temp_file_path, error_code);
+        return;
+    }
+    this->evict();
+}
+
+void ObjectCache::evict() const
+{
+    struct Entry final
+    {
+        std::filesystem::path path{};
+        std::uintmax_t size = 0UZ;
+        std::filesystem::file_time_type last_use{};
+    };
+    std::vector<Entry> entries{};
+    std::uintmax_t total_size = 0UZ;
+    std::error_code error_code;
+    const std::filesystem::file_time_type now = std::filesystem::file_time_type::clock::now();
+    for (
+        const std::filesystem::directory_entry& directory_entry :
+        std::filesystem::directory_iterator(this->directory, error_code)
+    )
+    {
+        const std::filesystem::path extension = directory_entry.path().extension();
+        if (extension == ".tmp")
+        { // left by a store that did not finish. recent ones may still be
+          // written by another process, so they only count toward the size.
+            const std::uintmax_t temp_size = directory_entry.file_size(error_code);
+            const std::filesystem::file_time_type temp_write_time = directory_entry.last_write_time(error_code);
+            if (error_code)
+            {
+                error_code.clear();
+                continue;
+            }
+            if (now - temp_write_time > r::STALE_TEMP_FILE_AGE)
+            {
+                std::filesystem::remove(directory_entry.path(), error_code);
+                error_code.clear();
+                continue;
+            }
+            total_size += temp_size;
+            continue;
+        }
+        if (extension != ".obj")
+        {
+            continue;
+        }
+        Entry entry{};
+        entry.path = directory_entry.path();
+        entry.size = directory_entry.file_size(error_code);
+        if (error_code)
+        { // removed by another process.
+            error_code.clear();
+            continue;
+        }
+        entry.last_use = directory_entry.last_write_time(error_code);
+        if (error_code)
+        {
+            error_code.clear();
+            continue;
+        }
+        total_size += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (total_size <= this->max_size)
+    {
+        return;
+    }
+    std::ranges::sort(
+        entries,
+        [](const Entry& lhs, const Entry& rhs)
+        {
+            return lhs.last_use < rhs.last_use;
+        }
+    );
+    for (const Entry& entry : entries)
+    {
+        if (total_size <= this->max_size)
+        {
+            break;
+        }
+        // an entry that another process already removed still frees its size.
+        std::filesystem::remove(entry.path, error_code);
+        total_size -= entry.size;
+    }
+}
+
+std::filesystem::path ObjectCache::get_entry_path(std::string_view key) const
+{
+    return this->directory / std::format("{}.obj", key);
+}
+
+}
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/IR/Module.h>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace r {
+
+// A content-addressed cache of object files shared between builds and between
+// compiler processes. Entries are named by a hash of everything that affects
+// code generation, published with an atomic rename, and evicted in least
+// recently used order once the directory grows past max_size.
+struct ObjectCache final
+{
+    std::filesystem::path directory{};
+    std::uintmax_t max_size = 1024UZ * 1024UZ * 1024UZ;
+
+    bool get_is_enabled() const noexcept;
+    std::string get_key(const llvm::Module& llvm_module, std::string_view codegen_options) const;
+    bool try_fetch(std::string_view key, const std::filesystem::path& obj_path) const;
+    void store(std::string_view key, const std::filesystem::path& obj_path) const;
+    void evict() const;
+
+private:
+    std::filesystem::path get_entry_path(std::string_view key) const;
+};
+
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <cstddef>
+
+namespace r {
+
+// the memory layout of an object for the target data layout. offsets are in
+// bytes and indexed by property_i.
+struct ObjectLayout final
+{
+    std::size_t byte_size = 0UZ;
+    std::size_t alignment = 1UZ;
+    std::size_t padding_byte_size = 0UZ;
+    // the size the object would have with its properties in declaration
+    // order. differs from byte_size only when properties are reordered.
+    std::size_t declared_byte_size = 0UZ;
+    llvm::SmallVector<std::size_t> property_offsets{};
+    // the struct field that holds each property, indexed by property_i.
+    llvm::SmallVector<unsigned> property_fields{};
+    // the property_i of each struct field, in field order.
+    llvm::SmallVector<std::size_t> field_properties{};
+};
+
+}
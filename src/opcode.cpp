@@ -4,11 +4,17 @@
 
 #include <opcode.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <utility>
 #include <unordered_map>
 #include <cstddef>
 #include <string_view>
 
+#define DEBUG_TYPE "requite-parser"
+
+ALWAYS_ENABLED_STATISTIC(NumOpcodeLookups, "words looked up as opcodes");
+
 namespace r {
 
 std::string_view to_string(r::Opcode opcode)
@@ -263,8 +269,12 @@ std::string_view to_string(r::Opcode opcode)
             return "no_autodestruct";
         case r::Opcode::PACKED:
             return "packed";
+        case r::Opcode::REORDER_PROPERTIES:
+            return "reorder_properties";
         case r::Opcode::VARIADIC_ARGUMENTS:
             return "variadic_arguments";
+        case r::Opcode::ANALYZE_THROUGHPUT:
+            return "analyze_throughput";
     }
     return "unknown";
 }
@@ -398,8 +408,11 @@ r::Opcode to_opcode(std::string_view str) {
             {"mangled_name", r::Opcode::MANGLED_NAME},
             {"no_autodestruct", r::Opcode::NO_AUTODESTRUCT},
             {"packed", r::Opcode::PACKED},
-            {"variadic_arguments", r::Opcode::VARIADIC_ARGUMENTS}
+            {"reorder_properties", r::Opcode::REORDER_PROPERTIES},
+            {"variadic_arguments", r::Opcode::VARIADIC_ARGUMENTS},
+            {"analyze_throughput", r::Opcode::ANALYZE_THROUGHPUT}
         };
+    ++NumOpcodeLookups;
     auto it = map.find(str);
     if (it != map.end()) 
     {
@@ -531,7 +544,9 @@ bool get_is_attribute_opcode(r::Opcode opcode)
         opcode == r::Opcode::NO_AUTODESTRUCT ||
         opcode == r::Opcode::MANGLED_NAME ||
         opcode == r::Opcode::PACKED ||
-        opcode == r::Opcode::VARIADIC_ARGUMENTS;
+        opcode == r::Opcode::REORDER_PROPERTIES ||
+        opcode == r::Opcode::VARIADIC_ARGUMENTS ||
+        opcode == r::Opcode::ANALYZE_THROUGHPUT;
 }
 
 bool get_opcode_returns_bool(r::Opcode opcode)
@@ -136,7 +136,9 @@ enum class Opcode
     MANGLED_NAME,
     NO_AUTODESTRUCT,
     PACKED,
-    VARIADIC_ARGUMENTS
+    REORDER_PROPERTIES,
+    VARIADIC_ARGUMENTS,
+    ANALYZE_THROUGHPUT
 };
 
 std::string_view to_string(r::Opcode opcode);
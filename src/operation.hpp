@@ -9,6 +9,7 @@
 
 #include <llvm/ADT/SmallVector.h>
 
+#include <cstddef>
 #include <string_view>
 #include <variant>
 #include <vector>
@@ -18,6 +19,8 @@ namespace r {
 struct Operation final
 {
     r::Opcode opcode = r::Opcode::UNKNOWN;
+    // the offset in the module source where this operation starts.
+    std::size_t source_i = 0UZ;
     std::vector<std::variant<std::string_view, r::Operation, r::Literal>> branches{};
 };
 
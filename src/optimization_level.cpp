@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <optimization_level.hpp>
+#include <utility.hpp>
+
+namespace r {
+
+llvm::OptimizationLevel to_llvm_optimization_level(r::OptimizationLevel optimization_level)
+{
+    switch (optimization_level)
+    {
+        case r::OptimizationLevel::O0:
+            return llvm::OptimizationLevel::O0;
+        case r::OptimizationLevel::O1:
+            return llvm::OptimizationLevel::O1;
+        case r::OptimizationLevel::O2:
+            return llvm::OptimizationLevel::O2;
+        case r::OptimizationLevel::O3:
+            return llvm::OptimizationLevel::O3;
+        case r::OptimizationLevel::OS:
+            return llvm::OptimizationLevel::Os;
+        case r::OptimizationLevel::OZ:
+            return llvm::OptimizationLevel::Oz;
+    }
+    r::unreachable();
+}
+
+llvm::CodeGenOptLevel to_llvm_codegen_opt_level(r::OptimizationLevel optimization_level)
+{
+    switch (optimization_level)
+    {
+        case r::OptimizationLevel::O0:
+            return llvm::CodeGenOptLevel::None;
+        case r::OptimizationLevel::O1:
+            return llvm::CodeGenOptLevel::Less;
+        case r::OptimizationLevel::O2:
+        case r::OptimizationLevel::OS:
+        case r::OptimizationLevel::OZ:
+            return llvm::CodeGenOptLevel::Default;
+        case r::OptimizationLevel::O3:
+            return llvm::CodeGenOptLevel::Aggressive;
+    }
+    r::unreachable();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Support/CodeGen.h>
+
+namespace r {
+
+enum class OptimizationLevel
+{
+    O0,
+    O1,
+    O2,
+    O3,
+    OS,
+    OZ
+};
+
+llvm::OptimizationLevel to_llvm_optimization_level(r::OptimizationLevel optimization_level);
+// the size levels generate code at the default level, the same as clang.
+llvm::CodeGenOptLevel to_llvm_codegen_opt_level(r::OptimizationLevel optimization_level);
+
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <optimization_remark_kind.hpp>
+#include <source_location.hpp>
+
+#include <string>
+
+namespace r {
+
+struct Procedure;
+
+// a remark from an llvm pass about a transformation it did, or could not do.
+struct OptimizationRemark final
+{
+    r::OptimizationRemarkKind kind = r::OptimizationRemarkKind::ANALYSIS;
+    std::string pass_name{};
+    std::string remark_name{};
+    std::string function_name{};
+    // the requite procedure the remark is about, if any.
+    r::Procedure* procedure = nullptr;
+    // only known when debug info is enabled.
+    r::SourceLocation location{};
+    std::string message{};
+};
+
+}
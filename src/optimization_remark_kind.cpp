@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <optimization_remark_kind.hpp>
+#include <utility.hpp>
+
+namespace r {
+
+std::string_view to_string(r::OptimizationRemarkKind kind)
+{
+    switch (kind)
+    {
+        case r::OptimizationRemarkKind::PASSED:
+            return "passed";
+        case r::OptimizationRemarkKind::MISSED:
+            return "missed";
+        case r::OptimizationRemarkKind::ANALYSIS:
+            return "analysis";
+    }
+    r::unreachable();
+}
+
+}
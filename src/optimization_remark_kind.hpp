@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <string_view>
+
+namespace r {
+
+enum class OptimizationRemarkKind
+{
+    PASSED,
+    MISSED,
+    ANALYSIS
+};
+
+std::string_view to_string(r::OptimizationRemarkKind kind);
+
+}
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <phase_timer.hpp>
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <stdexcept>
+
+namespace r {
+
+void PhaseTimer::start(std::string_view name)
+{
+    this->stop();
+    r::PhaseTime& phase = this->phases.emplace_back();
+    phase.name = name;
+    this->start_time = std::chrono::steady_clock::now();
+    this->is_running = true;
+}
+
+void PhaseTimer::stop()
+{
+    if (!this->is_running)
+    {
+        return;
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - this->start_time;
+    this->phases.back().seconds = duration.count();
+    this->is_running = false;
+}
+
+void PhaseTimer::clear() noexcept
+{
+    this->phases.clear();
+    this->is_running = false;
+}
+
+double PhaseTimer::get_total_seconds() const noexcept
+{
+    double total_seconds = 0.0;
+    for (const r::PhaseTime& phase : this->phases)
+    {
+        total_seconds += phase.seconds;
+    }
+    return total_seconds;
+}
+
+void PhaseTimer::write_json(const std::filesystem::path& path) const
+{
+    std::error_code error_code;
+    llvm::raw_fd_ostream ofile(path.c_str(), error_code, llvm::sys::fs::OF_Text);
+    if (error_code)
+    {
+        throw std::runtime_error(error_code.message());
+    }
+    llvm::json::OStream json(ofile, 2U);
+    json.object(
+        [&]()
+        {
+            json.attributeObject(
+                "phases",
+                [&]()
+                {
+                    for (const r::PhaseTime& phase : this->phases)
+                    {
+                        json.attribute(llvm::StringRef(phase.name), phase.seconds);
+                    }
+                }
+            );
+            json.attribute("total", this->get_total_seconds());
+        }
+    );
+    ofile << '\n';
+}
+
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+
+namespace r {
+
+struct PhaseTime final
+{
+    std::string_view name{};
+    double seconds = 0.0;
+};
+
+// Measures the wall time of each consecutive phase of a build.
+struct PhaseTimer final
+{
+    llvm::SmallVector<r::PhaseTime> phases{};
+
+    // ends the running phase, if any, and starts the next one.
+    void start(std::string_view name);
+    void stop();
+    void clear() noexcept;
+    double get_total_seconds() const noexcept;
+    void write_json(const std::filesystem::path& path) const;
+
+private:
+    std::chrono::steady_clock::time_point start_time{};
+    bool is_running = false;
+};
+
+}
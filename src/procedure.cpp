@@ -3,8 +3,12 @@
 // SPDX-License-Identifier: MIT
 
 #include <procedure.hpp>
+#include <object.hpp>
 
 #include <cassert>
+#include <format>
+#include <string>
+#include <string_view>
 
 namespace r {
 
@@ -80,4 +84,30 @@ r::Type Procedure::get_this_type() const noexcept
     return this_type;
 }
 
+std::string Procedure::get_qualified_name() const
+{
+    std::string_view name = this->name;
+    switch (this->category)
+    {
+        case r::ProcedureCategory::ENTRY_POINT:
+            name = "entry_point";
+            break;
+        case r::ProcedureCategory::DEFAULT_CONSTRUCTOR:
+            [[fallthrough]];
+        case r::ProcedureCategory::CONSTRUCTOR:
+            name = "constructor";
+            break;
+        case r::ProcedureCategory::DESTRUCTOR:
+            name = "destructor";
+            break;
+        default:
+            break;
+    }
+    if (this->object == nullptr)
+    {
+        return std::string(name);
+    }
+    return std::format("{}.{}", this->object->name, name);
+}
+
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <attributes.hpp>
 #include <type.hpp>
 #include <calling_convention.hpp>
+#include <catalog_state.hpp>
 
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Function.h>
@@ -35,6 +36,8 @@ struct Procedure final
     r::ProcedureCategory category = r::ProcedureCategory::UNKNOWN;
     r::Type return_type{};
     bool has_variadic_arguments = false;
+    // the whole body is analyzed by the throughput report, not just its loops.
+    bool analyze_throughput = false;
     llvm::SmallVector<r::ProcedureArgument> arguments{};
     // the index of the operation branch where the function body starts.
     std::size_t body_start_i = 0UZ;
@@ -45,12 +48,17 @@ struct Procedure final
     r::ProcedureGroup* procedure_group = nullptr;
     r::Attributes attributes;
     r::CallingConvention calling_convention = r::CallingConvention::C;
+    r::CatalogState catalog_state = r::CatalogState::TABULATED;
 
     // NOTE can be no pointer to any associated r::ProcedureGroup because it is stored in std::map.
     // not needed, so whatever.
 
     llvm::FunctionType* llvm_type = nullptr;
+    // only valid until the module is optimized, which may delete it.
     llvm::Function* llvm_function = nullptr;
+    // the ir name of the llvm function, recorded when it is created so the
+    // procedure can still be found after optimization.
+    std::string symbol_name{};
 
     bool get_has_body() const noexcept;
     bool get_is_instanced() const noexcept;
@@ -64,6 +72,10 @@ struct Procedure final
 
     r::Type get_sret_type() const noexcept;
     r::Type get_this_type() const noexcept;
+
+    // the name of the procedure as written in source, prefixed with the name
+    // of its object. (ex: Big.constructor)
+    std::string get_qualified_name() const;
 };
 
 }
\ No newline at end of file
@@ -10,10 +10,15 @@
 
 namespace r {
 
+struct InternedType;
+
 struct ProcedureArgument final
 {
     std::string_view name{};
     r::Type type{};
+    // set once type aliases are resolved, so overloads can be matched by
+    // handle.
+    const r::InternedType* interned_type = nullptr;
 };
 
 }
\ No newline at end of file
@@ -35,6 +35,10 @@ void ProcedureGroup::add_overload(r::Procedure& procedure, r::Resolver& resolver
     }
     resolver.check_overload_is_unique(*this, procedure);
     this->overloads.push_back(&procedure);
+    this->overload_index.clear();
+    this->unindexed_overloads.clear();
+    this->is_indexed = false;
+    this->resolution_cache.clear();
 }
 
 bool ProcedureGroup::get_is_empty() const noexcept
@@ -42,4 +46,67 @@ bool ProcedureGroup::get_is_empty() const noexcept
     return this->name.empty() || this->overloads.empty() || this->return_type.get_is_empty();
 }
 
+void ProcedureGroup::index_overloads()
+{
+    assert(!this->is_indexed);
+    // overloads can be resolved while cataloging objects, before type aliases
+    // are resolved. the index and cache would then hold matches against the
+    // aliases, so the group is left unindexed until they are gone.
+    for (const r::Procedure* overload : this->overloads)
+    {
+        for (const r::ProcedureArgument& argument : overload->arguments)
+        {
+            if (
+                argument.type.get_is_empty() ||
+                argument.type.get_is_type_alias()
+            )
+            {
+                return;
+            }
+        }
+    }
+    for (r::Procedure* overload : this->overloads)
+    {
+        if (overload->has_variadic_arguments)
+        {
+            this->unindexed_overloads.push_back(overload);
+            continue;
+        }
+        r::TypeKind first_argument_kind = r::TypeKind::UNKNOWN;
+        if (!overload->arguments.empty())
+        {
+            first_argument_kind = overload->arguments.front().type.get_kind();
+            if (first_argument_kind == r::TypeKind::UNKNOWN)
+            {
+                this->unindexed_overloads.push_back(overload);
+                continue;
+            }
+        }
+        this->overload_index[
+            {
+                static_cast<unsigned>(overload->arguments.size()),
+                static_cast<unsigned>(first_argument_kind)
+            }
+        ].push_back(overload);
+    }
+    this->is_indexed = true;
+}
+
+std::span<r::Procedure* const> ProcedureGroup::get_indexed_overloads(std::size_t argument_count, r::TypeKind first_argument_kind) const
+{
+    assert(this->is_indexed);
+    auto overloads_iter =
+        this->overload_index.find(
+            {
+                static_cast<unsigned>(argument_count),
+                static_cast<unsigned>(first_argument_kind)
+            }
+        );
+    if (overloads_iter == this->overload_index.end())
+    {
+        return {};
+    }
+    return overloads_iter->second;
+}
+
 }
\ No newline at end of file
@@ -7,29 +7,52 @@
 #include <type.hpp>
 #include <procedure_category.hpp>
 
+#include <type_kind.hpp>
+
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/SmallVector.h>
 
+#include <cstddef>
+#include <map>
 #include <string_view>
 #include <span>
+#include <utility>
 
 namespace r {
 
 struct Procedure;
 struct ProcedureArgument;
 struct Resolver;
+struct InternedType;
 
 using OverloadVector =
     llvm::SmallVector<r::Procedure*, 1UZ>;
 
+// the interned types of the arguments passed at a call site.
+using ArgumentSignature =
+    llvm::SmallVector<const r::InternedType*, 4UZ>;
+
 struct ProcedureGroup final
 {
     std::string_view name{};
     r::ProcedureCategory category = r::ProcedureCategory::UNKNOWN;
     r::OverloadVector overloads{};
     r::Type return_type{};
+    // overloads bucketed by argument count and the kind of their first
+    // argument. built on the first resolution once every argument type is
+    // resolved. variadic overloads are kept aside and always checked.
+    llvm::DenseMap<std::pair<unsigned, unsigned>, r::OverloadVector> overload_index{};
+    r::OverloadVector unindexed_overloads{};
+    bool is_indexed = false;
+    // the overload chosen for each argument signature already resolved.
+    // ambiguous and failed resolutions are not cached, so they throw again.
+    std::map<r::ArgumentSignature, r::Procedure*> resolution_cache{};
 
     void add_overload(r::Procedure& procedure, r::Resolver& resolver);
     bool get_is_empty() const noexcept;
+    // leaves is_indexed false while argument types are unresolved.
+    void index_overloads();
+    std::span<r::Procedure* const> get_indexed_overloads(std::size_t argument_count, r::TypeKind first_argument_kind) const;
 }; 
 
 }
\ No newline at end of file
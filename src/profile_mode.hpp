@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// How profile guided optimization is applied to the generated modules.
+enum class ProfileMode
+{
+    NONE,
+    // insert counters that write a raw profile when the linked program exits.
+    INSTRUMENT,
+    // read an indexed profile (.profdata) merged from instrumented runs.
+    USE
+};
+
+}
@@ -3,73 +3,688 @@
 // SPDX-License-Identifier: MIT
 
 #include <resolver/resolver.hpp>
+#include <builder/builder.hpp>
+#include <constant.hpp>
 #include <expression.hpp>
+#include <global.hpp>
+#include <literal.hpp>
+#include <local.hpp>
+#include <llvm_extensions.hpp>
+#include <opcode.hpp>
+#include <operation.hpp>
 #include <type.hpp>
+#include <utility.hpp>
 
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/APInt.h>
 #include <llvm/ADT/APSInt.h>
 
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <variant>
+
 namespace r {
 
-llvm::APSInt Resolver::get_integer_constant(const r::Expression& expression, const r::Type& expected_type)
+namespace {
+
+r::Constant make_integer_constant(const r::Type& type, const llvm::APInt& llvm_ap_int)
+{
+    assert(type.get_is_integer());
+    r::Constant constant{};
+    constant.type = type;
+    constant.type.clear_literals();
+    constant.value =
+        llvm::APSInt(
+            llvm_ap_int,
+            !type.get_is_signed_integer()
+        );
+    return constant;
+}
+
+r::Constant make_floating_point_constant(const r::Type& type, const llvm::APFloat& llvm_ap_float)
+{
+    assert(type.get_is_floating_point());
+    r::Constant constant{};
+    constant.type = type;
+    constant.type.clear_literals();
+    constant.value = llvm_ap_float;
+    return constant;
+}
+
+r::Constant make_bool_constant(bool value)
+{
+    r::Constant constant{};
+    constant.type = r::BOOL_TYPE;
+    constant.value = value;
+    return constant;
+}
+
+const llvm::fltSemantics& get_type_float_semantics(const r::Type& type)
+{
+    assert(type.get_is_floating_point());
+    return r::get_float_semantics(std::get<r::FloatingPoint>(type.root));
+}
+
+// converts the way construct converts between primitives. integers are
+// extended by the signedness they are converted from, and floating points
+// round towards zero when converted to integers.
+r::Constant convert_constant(const r::Constant& constant, const r::Type& type)
+{
+    if (type.get_is_integer())
+    {
+        const std::size_t bit_depth = type.get_integer().bit_depth;
+        if (std::holds_alternative<llvm::APSInt>(constant.value))
+        {
+            const llvm::APSInt& llvm_ap_sint = std::get<llvm::APSInt>(constant.value);
+            return r::make_integer_constant(type, llvm_ap_sint.extOrTrunc(bit_depth));
+        }
+        else if (std::holds_alternative<llvm::APFloat>(constant.value))
+        {
+            const llvm::APFloat& llvm_ap_float = std::get<llvm::APFloat>(constant.value);
+            llvm::APSInt llvm_ap_sint(bit_depth, !type.get_is_signed_integer());
+            bool is_exact = false;
+            llvm_ap_float.convertToInteger(
+                llvm_ap_sint,
+                llvm::APFloat::rmTowardZero,
+                &is_exact
+            );
+            return r::make_integer_constant(type, llvm_ap_sint);
+        }
+    }
+    else if (type.get_is_floating_point())
+    {
+        const llvm::fltSemantics& semantics = r::get_type_float_semantics(type);
+        if (std::holds_alternative<llvm::APSInt>(constant.value))
+        {
+            const llvm::APSInt& llvm_ap_sint = std::get<llvm::APSInt>(constant.value);
+            llvm::APFloat llvm_ap_float(semantics);
+            llvm_ap_float.convertFromAPInt(
+                llvm_ap_sint,
+                llvm_ap_sint.isSigned(),
+                llvm::APFloat::rmNearestTiesToEven
+            );
+            return r::make_floating_point_constant(type, llvm_ap_float);
+        }
+        else if (std::holds_alternative<llvm::APFloat>(constant.value))
+        {
+            llvm::APFloat llvm_ap_float = std::get<llvm::APFloat>(constant.value);
+            bool loses_info = false;
+            llvm_ap_float.convert(
+                semantics,
+                llvm::APFloat::rmNearestTiesToEven,
+                &loses_info
+            );
+            return r::make_floating_point_constant(type, llvm_ap_float);
+        }
+    }
+    else if (type.get_is_bool())
+    {
+        if (std::holds_alternative<bool>(constant.value))
+        {
+            return constant;
+        }
+    }
+    throw std::runtime_error("invalid constant conversion.");
+}
+
+// reinterprets the bits of a constant the way bit_cast does.
+r::Constant bit_cast_constant(const r::Constant& constant, const r::Type& type)
+{
+    llvm::APInt llvm_ap_int{};
+    if (std::holds_alternative<llvm::APSInt>(constant.value))
+    {
+        llvm_ap_int = std::get<llvm::APSInt>(constant.value);
+    }
+    else if (std::holds_alternative<llvm::APFloat>(constant.value))
+    {
+        llvm_ap_int = std::get<llvm::APFloat>(constant.value).bitcastToAPInt();
+    }
+    else
+    {
+        throw std::runtime_error("invalid constant bit cast.");
+    }
+    if (type.get_is_integer())
+    {
+        if (llvm_ap_int.getBitWidth() != type.get_integer().bit_depth)
+        {
+            throw std::runtime_error("must bit cast between types of same byte sizes.");
+        }
+        return r::make_integer_constant(type, llvm_ap_int);
+    }
+    else if (type.get_is_floating_point())
+    {
+        const llvm::fltSemantics& semantics = r::get_type_float_semantics(type);
+        if (llvm_ap_int.getBitWidth() != llvm::APFloat::semanticsSizeInBits(semantics))
+        {
+            throw std::runtime_error("must bit cast between types of same byte sizes.");
+        }
+        return r::make_floating_point_constant(type, llvm::APFloat(semantics, llvm_ap_int));
+    }
+    throw std::runtime_error("invalid constant bit cast.");
+}
+
+bool get_is_constant_primitive(const r::Type& type)
+{
+    return
+        type.get_is_integer() ||
+        type.get_is_floating_point() ||
+        type.get_is_bool();
+}
+
+}
+
+bool Resolver::get_is_constant(const r::Expression& expression, r::Builder* builder)
+{
+    if (
+        builder == nullptr ||
+        !std::holds_alternative<r::Operation>(expression)
+    )
+    { // names and literals are cheaper to check than to look up.
+        return this->get_is_uncached_constant(expression, builder);
+    }
+    const r::Operation& operation = std::get<r::Operation>(expression);
+    if (std::optional<bool> is_constant = builder->try_get_is_constant(operation))
+    {
+        return is_constant.value();
+    }
+    const bool is_constant = this->get_is_uncached_constant(expression, builder);
+    builder->add_is_constant(operation, is_constant);
+    return is_constant;
+}
+
+bool Resolver::get_is_uncached_constant(const r::Expression& expression, r::Builder* builder)
+{
+    if (std::holds_alternative<std::string_view>(expression))
+    {
+        std::string_view name = std::get<std::string_view>(expression);
+        if (builder != nullptr && builder->try_get_local(name) != nullptr)
+        {
+            return false;
+        }
+        r::Symbol* symbol = this->try_get_symbol(name);
+        if (symbol == nullptr || !std::holds_alternative<r::Global*>(*symbol))
+        {
+            return false;
+        }
+        r::Global& global = *std::get<r::Global*>(*symbol);
+        this->ensure_cataloged(global);
+        return global.value.has_value();
+    }
+    else if (std::holds_alternative<r::Literal>(expression))
+    {
+        const r::Literal& literal = std::get<r::Literal>(expression);
+        return
+            literal.type == r::LiteralType::NUMBER ||
+            literal.type == r::LiteralType::NUMBER_WITH_DECIMAL;
+    }
+    else if (std::holds_alternative<r::Operation>(expression))
+    {
+        const r::Operation& operation = std::get<r::Operation>(expression);
+        switch (operation.opcode)
+        {
+            case r::Opcode::TRUE:
+            case r::Opcode::FALSE:
+            case r::Opcode::POINTER_DEPTH:
+            case r::Opcode::SIZE_OF:
+                return true;
+            case r::Opcode::PLUS:
+            case r::Opcode::MINUS:
+            case r::Opcode::STAR:
+            case r::Opcode::DIVIDE:
+            case r::Opcode::MODULUS:
+            case r::Opcode::AND:
+            case r::Opcode::PIPE:
+            case r::Opcode::CAROT:
+            case r::Opcode::TILDE:
+            case r::Opcode::LESS_LESS:
+            case r::Opcode::GREATER_GREATER:
+            case r::Opcode::GREATER:
+            case r::Opcode::GREATER_EQUAL:
+            case r::Opcode::LESS:
+            case r::Opcode::LESS_EQUAL:
+            case r::Opcode::EQUAL_EQUAL:
+            case r::Opcode::BANG_EQUAL:
+            case r::Opcode::AND_AND:
+            case r::Opcode::PIPE_PIPE:
+            case r::Opcode::BANG:
+            case r::Opcode::QUESTION:
+                for (const r::Expression& branch : operation.branches)
+                {
+                    if (!this->get_is_constant(branch, builder))
+                    {
+                        return false;
+                    }
+                }
+                return !operation.branches.empty();
+            case r::Opcode::CONSTRUCT:
+            case r::Opcode::BIT_CAST:
+            {
+                if (operation.branches.size() != 2UZ)
+                {
+                    return false;
+                }
+                r::Type type = this->resolve_type(operation.branches.front(), true);
+                type.resolve_type_alias();
+                return
+                    r::get_is_constant_primitive(type) &&
+                    this->get_is_constant(operation.branches.back(), builder);
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+std::optional<r::Constant> Resolver::try_get_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder)
+{
+    if (!this->get_is_constant(expression, builder))
+    {
+        return std::nullopt;
+    }
+    return this->evaluate_constant(expression, expected_type, builder);
+}
+
+r::Constant Resolver::get_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder)
+{
+    std::optional<r::Constant> constant = this->try_get_constant(expression, expected_type, builder);
+    if (!constant.has_value())
+    {
+        throw std::runtime_error("expression is not a compile-time constant.");
+    }
+    return std::move(constant.value());
+}
+
+llvm::APSInt Resolver::get_integer_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder)
 {
     assert(expected_type.get_is_integer());
-    const r::Expression* cur_expression = &expression;
-    bool is_negative = false;
-    bool at_least_one_negative = false;
-    while (std::holds_alternative<r::Operation>(*cur_expression))
+    r::Constant constant = this->get_constant(expression, expected_type, builder);
+    return std::get<llvm::APSInt>(constant.value);
+}
+
+r::Constant Resolver::evaluate_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder)
+{
+    r::Type type = expected_type;
+    type.resolve_type_alias();
+    if (!r::get_is_constant_primitive(type))
+    {
+        throw std::runtime_error("constant must have a primitive type.");
+    }
+    if (std::holds_alternative<std::string_view>(expression))
     {
-        const r::Operation& cur_operation = std::get<r::Operation>(*cur_expression);
-        if (cur_operation.opcode == r::Opcode::MINUS)
+        std::string_view name = std::get<std::string_view>(expression);
+        r::Symbol* symbol = this->try_get_symbol(name);
+        assert(symbol != nullptr);
+        r::Global& global = *std::get<r::Global*>(*symbol);
+        assert(global.value.has_value());
+        this->check_type_assignable_to_type(global.type, type);
+        return r::convert_constant(global.value.value(), type);
+    }
+    else if (std::holds_alternative<r::Literal>(expression))
+    {
+        const r::Literal& literal = std::get<r::Literal>(expression);
+        if (type.get_is_integer())
         {
-            at_least_one_negative = true;
-            is_negative = !is_negative;
+            if (literal.type != r::LiteralType::NUMBER)
+            {
+                throw std::runtime_error("invalid literal type.");
+            }
+            const std::size_t bit_depth = type.get_integer().bit_depth;
+            llvm::APInt llvm_ap_int(
+                llvm::APInt::getBitsNeeded(literal.text, 10),
+                literal.text,
+                10
+            );
+            if (llvm_ap_int.getActiveBits() > bit_depth)
+            {
+                throw std::runtime_error("integer literal does not fit in type.");
+            }
+            return r::make_integer_constant(type, llvm_ap_int.zextOrTrunc(bit_depth));
         }
-        else if (cur_operation.opcode != r::Opcode::PLUS)
+        else if (type.get_is_floating_point())
         {
-            break;
+            return
+                r::make_floating_point_constant(
+                    type,
+                    llvm::APFloat(
+                        r::get_type_float_semantics(type),
+                        literal.text
+                    )
+                );
         }
-        assert(cur_operation.branches.size() == 1UZ);
-        cur_expression = &cur_operation.branches.front();
+        throw std::runtime_error("invalid literal type.");
     }
-    if (std::holds_alternative<r::Operation>(*cur_expression))
+    assert(std::holds_alternative<r::Operation>(expression));
+    const r::Operation& operation = std::get<r::Operation>(expression);
+    switch (operation.opcode)
     {
-        const r::Operation& cur_operation = std::get<r::Operation>(*cur_expression);
-        if (cur_operation.opcode == r::Opcode::POINTER_DEPTH)
+        case r::Opcode::TRUE:
+        case r::Opcode::FALSE:
+            this->check_type_assignable_to_type(r::BOOL_TYPE, type);
+            return r::make_bool_constant(operation.opcode == r::Opcode::TRUE);
+        case r::Opcode::POINTER_DEPTH:
+        case r::Opcode::SIZE_OF:
         {
-            assert(cur_operation.branches.empty());
-            assert(!at_least_one_negative);
-            std::size_t pointer_depth = this->get_pointer_bit_depth();
             r::Type uptr_type = this->get_uptr_type();
-            this->check_type_assignable_to_type(uptr_type, expected_type);
-            return
-                llvm::APSInt(
+            this->check_type_assignable_to_type(uptr_type, type);
+            const std::size_t value =
+                operation.opcode == r::Opcode::POINTER_DEPTH ?
+                this->get_pointer_bit_depth() :
+                this->get_size_of(operation, builder);
+            r::Constant constant =
+                r::make_integer_constant(
+                    uptr_type,
                     llvm::APInt(
-                        pointer_depth,
-                        std::to_array({static_cast<std::uint64_t>(pointer_depth)})
-                    ),
-                    false
+                        this->get_pointer_bit_depth(),
+                        static_cast<std::uint64_t>(value)
+                    )
                 );
+            return r::convert_constant(constant, type);
         }
+        case r::Opcode::PLUS:
+        case r::Opcode::MINUS:
+            if (operation.branches.size() == 1UZ)
+            {
+                r::Constant constant = this->evaluate_constant(operation.branches.front(), type, builder);
+                if (operation.opcode == r::Opcode::PLUS)
+                {
+                    return constant;
+                }
+                if (std::holds_alternative<llvm::APSInt>(constant.value))
+                {
+                    llvm::APSInt& llvm_ap_sint = std::get<llvm::APSInt>(constant.value);
+                    llvm_ap_sint.negate();
+                }
+                else if (std::holds_alternative<llvm::APFloat>(constant.value))
+                {
+                    llvm::APFloat& llvm_ap_float = std::get<llvm::APFloat>(constant.value);
+                    llvm_ap_float.changeSign();
+                }
+                else
+                {
+                    throw std::runtime_error("must be numeric primitive type.");
+                }
+                return constant;
+            }
+            return this->evaluate_constant_group(operation, type, builder);
+        case r::Opcode::STAR:
+        case r::Opcode::DIVIDE:
+        case r::Opcode::MODULUS:
+        case r::Opcode::AND:
+        case r::Opcode::PIPE:
+        case r::Opcode::CAROT:
+            return this->evaluate_constant_group(operation, type, builder);
+        case r::Opcode::TILDE:
+        {
+            assert(operation.branches.size() == 1UZ);
+            r::Constant constant = this->evaluate_constant(operation.branches.front(), type, builder);
+            if (!std::holds_alternative<llvm::APSInt>(constant.value))
+            {
+                throw std::runtime_error("invalid type.");
+            }
+            std::get<llvm::APSInt>(constant.value).flipAllBits();
+            return constant;
+        }
+        case r::Opcode::LESS_LESS:
+        case r::Opcode::GREATER_GREATER:
+        {
+            assert(operation.branches.size() == 2UZ);
+            r::Constant constant = this->evaluate_constant(operation.branches.front(), type, builder);
+            r::Constant shift_constant = this->evaluate_constant(operation.branches.back(), type, builder);
+            if (!std::holds_alternative<llvm::APSInt>(constant.value))
+            {
+                throw std::runtime_error("invalid type.");
+            }
+            llvm::APSInt& llvm_ap_sint = std::get<llvm::APSInt>(constant.value);
+            const llvm::APSInt& shift = std::get<llvm::APSInt>(shift_constant.value);
+            if (shift.isNegative() || shift.uge(llvm_ap_sint.getBitWidth()))
+            {
+                throw std::runtime_error("shift amount must be less than the bit depth.");
+            }
+            const unsigned shift_amount = static_cast<unsigned>(shift.getZExtValue());
+            llvm_ap_sint =
+                operation.opcode == r::Opcode::LESS_LESS ?
+                llvm_ap_sint << shift_amount :
+                llvm_ap_sint >> shift_amount;
+            return constant;
+        }
+        case r::Opcode::GREATER:
+        case r::Opcode::GREATER_EQUAL:
+        case r::Opcode::LESS:
+        case r::Opcode::LESS_EQUAL:
+        case r::Opcode::EQUAL_EQUAL:
+        case r::Opcode::BANG_EQUAL:
+            return this->evaluate_constant_comparison(operation, type, builder);
+        case r::Opcode::AND_AND:
+        case r::Opcode::PIPE_PIPE:
+        {
+            assert(operation.branches.size() >= 2UZ);
+            this->check_type_assignable_to_type(r::BOOL_TYPE, type);
+            const bool is_and = operation.opcode == r::Opcode::AND_AND;
+            bool result = is_and;
+            for (const r::Expression& branch : operation.branches)
+            {
+                r::Constant constant = this->evaluate_constant(branch, r::BOOL_TYPE, builder);
+                if (std::get<bool>(constant.value) != is_and)
+                { // short circuits the same way the generated code does.
+                    result = !is_and;
+                    break;
+                }
+            }
+            return r::make_bool_constant(result);
+        }
+        case r::Opcode::BANG:
+        {
+            assert(operation.branches.size() == 1UZ);
+            r::Constant constant = this->evaluate_constant(operation.branches.front(), r::BOOL_TYPE, builder);
+            return r::make_bool_constant(!std::get<bool>(constant.value));
+        }
+        case r::Opcode::QUESTION:
+        {
+            assert(operation.branches.size() == 3UZ);
+            r::Constant condition = this->evaluate_constant(operation.branches.front(), r::BOOL_TYPE, builder);
+            const r::Expression& chosen_expression =
+                std::get<bool>(condition.value) ?
+                operation.branches.at(1UZ) :
+                operation.branches.back();
+            return this->evaluate_constant(chosen_expression, type, builder);
+        }
+        case r::Opcode::CONSTRUCT:
+        case r::Opcode::BIT_CAST:
+            return this->evaluate_constant_cast(operation, type, builder);
+        default:
+            break;
     }
-    assert(std::holds_alternative<r::Literal>(*cur_expression));
-    const r::Literal& literal = std::get<r::Literal>(*cur_expression);
-    assert(literal.type == r::LiteralType::NUMBER);
-    r::Integer integer = std::get<r::Integer>(expected_type.root);
-    llvm::APInt llvm_ap_int =
-        llvm::APInt(
-            integer.bit_depth,
-            literal.text,
-            10
-        );
-    if (is_negative)
+    r::unreachable();
+}
+
+r::Constant Resolver::evaluate_constant_group(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder)
+{
+    assert(operation.branches.size() >= 2UZ);
+    r::Type group_type = this->deduce_group_type(operation.branches, builder);
+    this->check_type_assignable_to_type(group_type, expected_type);
+    if (group_type.get_is_literal())
+    { // literals take the type they are expected to have.
+        group_type = expected_type;
+    }
+    group_type.clear_literals();
+    r::Constant result = this->evaluate_constant(operation.branches.front(), group_type, builder);
+    for (const r::Expression& branch : std::span(operation.branches).subspan(1UZ))
     {
-        llvm_ap_int.flipAllBits();
+        r::Constant next = this->evaluate_constant(branch, group_type, builder);
+        if (std::holds_alternative<llvm::APSInt>(result.value))
+        {
+            llvm::APSInt& lhs = std::get<llvm::APSInt>(result.value);
+            const llvm::APSInt& rhs = std::get<llvm::APSInt>(next.value);
+            switch (operation.opcode)
+            {
+                case r::Opcode::PLUS:
+                    lhs += rhs;
+                    break;
+                case r::Opcode::MINUS:
+                    lhs -= rhs;
+                    break;
+                case r::Opcode::STAR:
+                    lhs *= rhs;
+                    break;
+                case r::Opcode::DIVIDE:
+                    if (rhs.isZero())
+                    {
+                        throw std::runtime_error("division by zero.");
+                    }
+                    lhs /= rhs;
+                    break;
+                case r::Opcode::MODULUS:
+                    if (rhs.isZero())
+                    {
+                        throw std::runtime_error("division by zero.");
+                    }
+                    lhs %= rhs;
+                    break;
+                case r::Opcode::AND:
+                    lhs &= rhs;
+                    break;
+                case r::Opcode::PIPE:
+                    lhs |= rhs;
+                    break;
+                case r::Opcode::CAROT:
+                    lhs ^= rhs;
+                    break;
+                default:
+                    r::unreachable();
+            }
+        }
+        else if (std::holds_alternative<llvm::APFloat>(result.value))
+        {
+            llvm::APFloat& lhs = std::get<llvm::APFloat>(result.value);
+            const llvm::APFloat& rhs = std::get<llvm::APFloat>(next.value);
+            switch (operation.opcode)
+            {
+                case r::Opcode::PLUS:
+                    lhs.add(rhs, llvm::APFloat::rmNearestTiesToEven);
+                    break;
+                case r::Opcode::MINUS:
+                    lhs.subtract(rhs, llvm::APFloat::rmNearestTiesToEven);
+                    break;
+                case r::Opcode::STAR:
+                    lhs.multiply(rhs, llvm::APFloat::rmNearestTiesToEven);
+                    break;
+                case r::Opcode::DIVIDE:
+                    lhs.divide(rhs, llvm::APFloat::rmNearestTiesToEven);
+                    break;
+                case r::Opcode::MODULUS:
+                    lhs.mod(rhs);
+                    break;
+                default:
+                    throw std::runtime_error("invalid type.");
+            }
+        }
+        else
+        {
+            throw std::runtime_error("must be numeric primitive type.");
+        }
     }
-    return 
-        llvm::APSInt(
-            llvm_ap_int,
-            expected_type.get_is_signed_integer()
-        );
+    return r::convert_constant(result, expected_type);
 }
 
-}
\ No newline at end of file
+r::Constant Resolver::evaluate_constant_comparison(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder)
+{
+    assert(operation.branches.size() >= 2UZ);
+    this->check_type_assignable_to_type(r::BOOL_TYPE, expected_type);
+    r::Type argument_type = this->deduce_group_type(operation.branches, builder);
+    argument_type.clear_literals();
+    r::Constant lhs = this->evaluate_constant(operation.branches.front(), argument_type, builder);
+    bool result = true;
+    for (const r::Expression& branch : std::span(operation.branches).subspan(1UZ))
+    {
+        r::Constant rhs = this->evaluate_constant(branch, argument_type, builder);
+        bool is_greater = false;
+        bool is_less = false;
+        bool is_equal = false;
+        if (std::holds_alternative<llvm::APSInt>(lhs.value))
+        {
+            const llvm::APSInt& lhs_int = std::get<llvm::APSInt>(lhs.value);
+            const llvm::APSInt& rhs_int = std::get<llvm::APSInt>(rhs.value);
+            is_greater = lhs_int > rhs_int;
+            is_less = lhs_int < rhs_int;
+            is_equal = lhs_int == rhs_int;
+        }
+        else if (std::holds_alternative<llvm::APFloat>(lhs.value))
+        { // ordered comparisons, so nothing compares to nan.
+            const llvm::APFloat::cmpResult compare_result =
+                std::get<llvm::APFloat>(lhs.value).compare(std::get<llvm::APFloat>(rhs.value));
+            is_greater = compare_result == llvm::APFloat::cmpGreaterThan;
+            is_less = compare_result == llvm::APFloat::cmpLessThan;
+            is_equal = compare_result == llvm::APFloat::cmpEqual;
+        }
+        else
+        {
+            if (
+                operation.opcode != r::Opcode::EQUAL_EQUAL &&
+                operation.opcode != r::Opcode::BANG_EQUAL
+            )
+            {
+                throw std::runtime_error("invalid type.");
+            }
+            is_equal = std::get<bool>(lhs.value) == std::get<bool>(rhs.value);
+            is_greater = !is_equal;
+        }
+        switch (operation.opcode)
+        {
+            case r::Opcode::GREATER:
+                result = result && is_greater;
+                break;
+            case r::Opcode::GREATER_EQUAL:
+                result = result && (is_greater || is_equal);
+                break;
+            case r::Opcode::LESS:
+                result = result && is_less;
+                break;
+            case r::Opcode::LESS_EQUAL:
+                result = result && (is_less || is_equal);
+                break;
+            case r::Opcode::EQUAL_EQUAL:
+                result = result && is_equal;
+                break;
+            case r::Opcode::BANG_EQUAL:
+                result = result && (is_greater || is_less);
+                break;
+            default:
+                r::unreachable();
+        }
+        lhs = std::move(rhs);
+    }
+    return r::make_bool_constant(result);
+}
+
+r::Constant Resolver::evaluate_constant_cast(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder)
+{
+    assert(operation.branches.size() == 2UZ);
+    r::Type type = this->resolve_type(operation.branches.front());
+    type.resolve_type_alias();
+    this->check_type_assignable_to_type(type, expected_type);
+    const r::Expression& value_expression = operation.branches.back();
+    r::Type value_type = this->deduce_type(value_expression, builder);
+    if (value_type.get_is_literal())
+    { // literals take the type they are cast to.
+        return
+            r::convert_constant(
+                this->evaluate_constant(value_expression, type, builder),
+                expected_type
+            );
+    }
+    value_type.resolve_type_alias();
+    r::Constant value = this->evaluate_constant(value_expression, value_type, builder);
+    r::Constant result =
+        operation.opcode == r::Opcode::BIT_CAST ?
+        r::bit_cast_constant(value, type) :
+        r::convert_constant(value, type);
+    return r::convert_constant(result, expected_type);
+}
+
+}
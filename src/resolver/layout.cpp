@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <resolver/resolver.hpp>
+#include <binary.hpp>
+#include <object.hpp>
+#include <object_layout.hpp>
+#include <property.hpp>
+#include <operation.hpp>
+#include <opcode.hpp>
+#include <type.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/Support/Alignment.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+namespace r {
+
+namespace {
+
+// places the properties in field order the same way llvm lays out a struct
+// type, and returns the unpadded end of the last one.
+std::size_t place_properties(std::span<const std::size_t> field_properties, std::span<const std::size_t> sizes, std::span<const std::size_t> alignments, llvm::SmallVectorImpl<std::size_t>& offsets)
+{
+    std::size_t offset = 0UZ;
+    for (std::size_t property_i : field_properties)
+    {
+        offset = llvm::alignTo(offset, alignments[property_i]);
+        offsets[property_i] = offset;
+        offset += sizes[property_i];
+    }
+    return offset;
+}
+
+}
+
+const r::ObjectLayout& Resolver::get_object_layout(r::Object& object)
+{
+    if (object.layout.has_value())
+    {
+        return object.layout.value();
+    }
+    this->ensure_cataloged(object);
+    if (object.is_laying_out)
+    {
+        throw std::runtime_error("object can not contain itself.");
+    }
+    object.is_laying_out = true;
+    const std::size_t property_count = object.properties.size();
+    llvm::SmallVector<std::size_t> sizes{};
+    llvm::SmallVector<std::size_t> alignments{};
+    sizes.reserve(property_count);
+    alignments.reserve(property_count);
+    r::ObjectLayout layout{};
+    std::size_t properties_byte_size = 0UZ;
+    for (const std::unique_ptr<r::Property>& property_ptr : object.properties)
+    {
+        assert(property_ptr.get() != nullptr);
+        r::Type property_type = property_ptr->type;
+        property_type.resolve_type_alias();
+        const std::size_t property_size = this->get_byte_size(property_type);
+        const std::size_t property_alignment =
+            object.is_packed ?
+            1UZ :
+            this->get_alignment(property_type);
+        sizes.push_back(property_size);
+        alignments.push_back(property_alignment);
+        properties_byte_size += property_size;
+        layout.alignment = std::max(layout.alignment, property_alignment);
+    }
+    layout.property_offsets.resize(property_count);
+    layout.field_properties.reserve(property_count);
+    for (std::size_t property_i = 0UZ; property_i < property_count; property_i++)
+    {
+        layout.field_properties.push_back(property_i);
+    }
+    layout.declared_byte_size =
+        llvm::alignTo(
+            r::place_properties(layout.field_properties, sizes, alignments, layout.property_offsets),
+            layout.alignment
+        );
+    layout.byte_size = layout.declared_byte_size;
+    if (object.reorders_properties)
+    {
+        // most aligned first, keeping declaration order between properties
+        // of equal alignment. construction and destruction still follow
+        // declaration order.
+        std::stable_sort(
+            layout.field_properties.begin(),
+            layout.field_properties.end(),
+            [&](std::size_t property_a_i, std::size_t property_b_i)
+            {
+                return alignments[property_a_i] > alignments[property_b_i];
+            }
+        );
+        layout.byte_size =
+            llvm::alignTo(
+                r::place_properties(layout.field_properties, sizes, alignments, layout.property_offsets),
+                layout.alignment
+            );
+    }
+    layout.padding_byte_size = layout.byte_size - properties_byte_size;
+    layout.property_fields.resize(property_count);
+    for (std::size_t field_i = 0UZ; field_i < property_count; field_i++)
+    {
+        layout.property_fields[layout.field_properties[field_i]] = static_cast<unsigned>(field_i);
+    }
+    object.is_laying_out = false;
+    object.layout = std::move(layout);
+    return object.layout.value();
+}
+
+std::size_t Resolver::get_byte_size(const r::Type& type)
+{
+    assert(this->binary->llvm_data_layout != nullptr);
+    const llvm::DataLayout& llvm_data_layout = *this->binary->llvm_data_layout.get();
+    if (type.get_is_pointer())
+    {
+        return llvm_data_layout.getPointerSize();
+    }
+    else if (type.get_is_array())
+    {
+        r::Type element = type;
+        element.subtypes.pop_back();
+        const std::size_t element_size = this->get_byte_size(element);
+        if (type.get_array_size() == 0UZ)
+        {
+            return element_size;
+        }
+        return element_size * type.get_array_size();
+    }
+    else if (type.get_is_object())
+    {
+        r::Object& object = *std::get<r::Object*>(type.root);
+        return this->get_object_layout(object).byte_size;
+    }
+    else if (std::holds_alternative<r::FixedPoint>(type.root))
+    {
+        return llvm::divideCeil(this->get_bit_depth(type), 8UZ);
+    }
+    llvm::Type* llvm_type = this->get_llvm_type(type);
+    if (!llvm_type->isSized())
+    {
+        throw std::runtime_error("type has no size.");
+    }
+    return llvm_data_layout.getTypeAllocSize(llvm_type).getFixedValue();
+}
+
+std::size_t Resolver::get_alignment(const r::Type& type)
+{
+    assert(this->binary->llvm_data_layout != nullptr);
+    const llvm::DataLayout& llvm_data_layout = *this->binary->llvm_data_layout.get();
+    if (type.get_is_pointer())
+    {
+        return llvm_data_layout.getPointerABIAlignment(0).value();
+    }
+    else if (type.get_is_array())
+    {
+        r::Type element = type;
+        element.subtypes.pop_back();
+        return this->get_alignment(element);
+    }
+    else if (type.get_is_object())
+    {
+        r::Object& object = *std::get<r::Object*>(type.root);
+        return this->get_object_layout(object).alignment;
+    }
+    else if (std::holds_alternative<r::FixedPoint>(type.root))
+    {
+        llvm::Type* llvm_type =
+            llvm::Type::getIntNTy(
+                this->get_llvm_context(),
+                this->get_bit_depth(type)
+            );
+        return llvm_data_layout.getABITypeAlign(llvm_type).value();
+    }
+    llvm::Type* llvm_type = this->get_llvm_type(type);
+    if (!llvm_type->isSized())
+    {
+        throw std::runtime_error("type has no size.");
+    }
+    return llvm_data_layout.getABITypeAlign(llvm_type).value();
+}
+
+std::size_t Resolver::get_size_of(const r::Operation& operation, r::Builder* builder)
+{
+    assert(operation.opcode == r::Opcode::SIZE_OF);
+    if (operation.branches.size() != 1UZ)
+    {
+        throw std::runtime_error("size_of must have one branch.");
+    }
+    const r::Expression& branch = operation.branches.front();
+    r::Type type = this->resolve_type(branch, true);
+    if (type.get_is_empty())
+    {
+        type = this->deduce_type(branch, builder);
+        type.clear_literals();
+    }
+    type.resolve_type_alias();
+    return this->get_byte_size(type);
+}
+
+}
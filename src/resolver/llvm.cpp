@@ -10,14 +10,19 @@
 #include <llvm_extensions.hpp>
 #include <type_alias.hpp>
 #include <object.hpp>
+#include <object_layout.hpp>
+#include <property.hpp>
 
 #include <llvm/IR/Type.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/TargetParser/Host.h>
 
 #include <string>
 #include <memory>
 #include <ranges>
+#include <cstddef>
 
 namespace r {
 
@@ -118,7 +123,36 @@ llvm::Type* Resolver::get_llvm_type(const r::FixedPoint& fixed_point)
 
 llvm::Type* Resolver::get_llvm_type(r::Object& object)
 {
-    return object.llvm_struct_type;
+    if (object.llvm_struct_type != nullptr)
+    {
+        return object.llvm_struct_type;
+    }
+    // fields are ordered by the layout, which may differ from declaration
+    // order when properties are reordered. the struct is named before its
+    // body is set so properties can point back to the object.
+    const r::ObjectLayout& layout = this->get_object_layout(object);
+    llvm::StructType* llvm_struct_type =
+        llvm::StructType::
+            create(
+                this->get_llvm_context(),
+                object.name
+            );
+    object.llvm_struct_type = llvm_struct_type;
+    llvm::SmallVector<llvm::Type*> llvm_property_types{};
+    llvm_property_types.reserve(layout.field_properties.size());
+    for (std::size_t property_i : layout.field_properties)
+    {
+        const r::Property& property = *object.properties[property_i].get();
+        llvm_property_types.push_back(
+            this->get_llvm_type(property.type)
+        );
+    }
+    llvm_struct_type->
+        setBody(
+            llvm_property_types,
+            object.is_packed
+        );
+    return llvm_struct_type;
 }
 
 llvm::Type* Resolver::get_llvm_type(const r::Type& type, std::size_t dropped_subtypes)
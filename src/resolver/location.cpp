@@ -91,4 +91,21 @@ void Resolver::enter(r::TypeAlias& type_alias)
     }
 }
 
+void Resolver::enter(r::Global& global)
+{
+    assert(global.module != nullptr);
+    if (global.object != nullptr)
+    {
+        this->enter(*global.object);
+    }
+    else if (global.export_group != nullptr)
+    {
+        this->enter(*global.export_group, *global.module);
+    }
+    else
+    {
+        this->enter(*global.module);
+    }
+}
+
 }
\ No newline at end of file
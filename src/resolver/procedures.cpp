@@ -9,9 +9,24 @@
 #include <utility.hpp>
 #include <procedure.hpp>
 #include <object.hpp>
+#include <type_context.hpp>
+#include <type_kind.hpp>
+#include <procedure_argument.hpp>
 
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/Statistic.h>
+
+#include <cassert>
+#include <cstddef>
 #include <stdexcept>
 #include <ranges>
+#include <utility>
+
+#define DEBUG_TYPE "requite-resolver"
+
+ALWAYS_ENABLED_STATISTIC(NumOverloadResolutions, "overload resolutions");
+ALWAYS_ENABLED_STATISTIC(NumOverloadCandidates, "overload candidates examined");
+ALWAYS_ENABLED_STATISTIC(NumOverloadCacheHits, "overload resolutions found in the call-site cache");
 
 namespace r {
 
@@ -105,48 +120,132 @@ r::Procedure& Resolver::get_construct_procedure(const r::Operation& call_operati
 r::Procedure& Resolver::get_best_overload(r::ProcedureGroup& procedure_group, std::span<const r::Type> arguments)
 {
     assert(!procedure_group.overloads.empty());
-    r::Procedure* chosen_overload = nullptr;
+    ++NumOverloadResolutions;
+    // arguments that are the same interned type as a parameter match without
+    // checking assignability.
+    r::TypeContext& type_context = this->get_type_context();
+    r::ArgumentSignature interned_arguments{};
+    interned_arguments.reserve(arguments.size());
+    for (const r::Type& argument : arguments)
+    {
+        interned_arguments.push_back(&type_context.intern(argument));
+    }
+    auto cache_iter = procedure_group.resolution_cache.find(interned_arguments);
+    if (cache_iter != procedure_group.resolution_cache.end())
+    {
+        ++NumOverloadCacheHits;
+        return *cache_iter->second;
+    }
     for (r::Procedure* overload : procedure_group.overloads)
     {
-        if (overload->has_variadic_arguments)
+        this->ensure_cataloged(*overload);
+    }
+    if (!procedure_group.is_indexed)
+    {
+        procedure_group.index_overloads();
+    }
+    r::Procedure* chosen_overload = nullptr;
+    auto check_overload =
+        [&](r::Procedure* overload)
         {
-            if (overload->arguments.size() > arguments.size())
+            ++NumOverloadCandidates;
+            if (overload->has_variadic_arguments)
+            {
+                if (overload->arguments.size() > arguments.size())
+                {
+                    return;
+                }
+            }
+            else
+            {
+                if (overload->arguments.size() != arguments.size())
+                {
+                    return;
+                }
+            }
+            for (std::size_t arg_i = 0UZ; arg_i < overload->arguments.size(); arg_i++)
+            {
+                const r::ProcedureArgument& overload_arg = overload->arguments[arg_i];
+                if (overload_arg.interned_type == interned_arguments[arg_i])
+                {
+                    continue;
+                }
+                const r::Type& arg_type = arguments[arg_i];
+                if (!this->get_is_type_assignable_to_type(arg_type, overload_arg.type))
+                {
+                    return;
+                }
+            }
+            if (chosen_overload != nullptr)
             {
-                continue;
+                throw std::runtime_error("can not choose overload due to ambiguity.");
             }
+            chosen_overload = overload;
+        };
+    // the kinds of first parameter that the first argument can be assigned
+    // to. integer literals also convert to floating points, and other
+    // literals are not checked by kind, so those fall back to every overload.
+    llvm::SmallVector<r::TypeKind, 2UZ> candidate_kinds{};
+    bool is_full_scan = !procedure_group.is_indexed;
+    if (arguments.empty())
+    {
+        candidate_kinds.push_back(r::TypeKind::UNKNOWN);
+    }
+    else
+    {
+        const r::Type& first_argument = arguments.front();
+        r::TypeKind first_argument_kind = first_argument.get_kind();
+        if (first_argument_kind == r::TypeKind::UNKNOWN)
+        {
+            is_full_scan = true;
+        }
+        else if (!first_argument.get_is_literal())
+        {
+            candidate_kinds.push_back(first_argument_kind);
+        }
+        else if (first_argument.get_is_integer())
+        {
+            candidate_kinds.push_back(r::TypeKind::INTEGER);
+            candidate_kinds.push_back(r::TypeKind::FLOATING_POINT);
+        }
+        else if (first_argument.get_is_floating_point())
+        {
+            candidate_kinds.push_back(r::TypeKind::FLOATING_POINT);
         }
         else
         {
-            if (overload->arguments.size() != arguments.size())
-            {
-                continue;
-            }
+            is_full_scan = true;
         }
-        bool fail = false;
-        for (std::size_t arg_i = 0UZ; arg_i < overload->arguments.size(); arg_i++)
+    }
+    if (is_full_scan)
+    {
+        for (r::Procedure* overload : procedure_group.overloads)
         {
-            const r::ProcedureArgument& overload_arg = overload->arguments[arg_i];
-            const r::Type& arg_type = arguments[arg_i];
-            if (!this->get_is_type_assignable_to_type(arg_type, overload_arg.type))
-            {
-                fail = true;
-                break;
-            }
+            check_overload(overload);
         }
-        if (fail)
+    }
+    else
+    {
+        for (r::TypeKind candidate_kind : candidate_kinds)
         {
-            continue;
+            for (r::Procedure* overload : procedure_group.get_indexed_overloads(arguments.size(), candidate_kind))
+            {
+                check_overload(overload);
+            }
         }
-        if (chosen_overload != nullptr)
+        for (r::Procedure* overload : procedure_group.unindexed_overloads)
         {
-            throw std::runtime_error("can not choose overload due to ambiguity.");
+            check_overload(overload);
         }
-        chosen_overload = overload;
     }
     if (chosen_overload == nullptr)
     {
         throw std::runtime_error("no function of name with matching arguments.");
     }
+    if (procedure_group.is_indexed)
+    {
+        procedure_group.resolution_cache.try_emplace(std::move(interned_arguments), chosen_overload);
+    }
     return *chosen_overload;
 }
 
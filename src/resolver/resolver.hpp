@@ -13,6 +13,7 @@
 #include <llvm/ADT/APSInt.h>
 
 #include <cstddef>
+#include <optional>
 #include <span>
 
 namespace r {
@@ -33,6 +34,10 @@ struct Integer;
 struct Codeunit;
 struct FloatingPoint;
 struct FixedPoint;
+struct TypeContext;
+struct ObjectLayout;
+struct Global;
+struct Constant;
 
 // Tracks the current global scope being processed and performs type operations
 // such as resolution and deduction.
@@ -52,10 +57,23 @@ struct Resolver final
    void enter(r::Object& object);
    void enter(r::Procedure& procedure);
    void enter(r::TypeAlias& type_alias);
+   void enter(r::Global& global);
    void clear();
 
    // constants.cpp
-   llvm::APSInt get_integer_constant(const r::Expression& expression, const r::Type& expected_type);
+   // constants are evaluated in the type they are expected to have, the same
+   // way the builder generates values. with a builder, locals are never
+   // constant and whether an operation is constant is cached for the scope
+   // it was checked in.
+   bool get_is_constant(const r::Expression& expression, r::Builder* builder = nullptr);
+   bool get_is_uncached_constant(const r::Expression& expression, r::Builder* builder = nullptr);
+   std::optional<r::Constant> try_get_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder = nullptr);
+   r::Constant get_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder = nullptr);
+   llvm::APSInt get_integer_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder = nullptr);
+   r::Constant evaluate_constant(const r::Expression& expression, const r::Type& expected_type, r::Builder* builder);
+   r::Constant evaluate_constant_group(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder);
+   r::Constant evaluate_constant_comparison(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder);
+   r::Constant evaluate_constant_cast(const r::Operation& operation, const r::Type& expected_type, r::Builder* builder);
 
    // types.cpp
    bool get_is_type_assignable_to_type(const r::Type& from, const r::Type& to);
@@ -63,12 +81,15 @@ struct Resolver final
    void check_dereferenced_type_assignable_to_type(const r::Type& from, const r::Type& to);
    void check_indexed_type_assignable_to_type(const r::Type& from, const r::Type& to);
    std::size_t get_bit_depth(const r::Type& type);
-   std::size_t get_byte_size(const r::Type& type);
    r::Type resolve_type(const r::Expression& expression, bool can_fail = false);
+   // with a builder, the deduced types of operations are cached for the
+   // scope they were deduced in.
    r::Type deduce_type(const r::Expression& expression, r::Builder* builder = nullptr);
+   r::Type deduce_uncached_type(const r::Expression& expression, r::Builder* builder = nullptr);
    r::Type deduce_group_type(std::span<const r::Expression> branch_group, r::Builder* builder = nullptr);
    r::Type deduce_group_type(const r::Type& type_a, const r::Type& type_b);
    r::Type get_uptr_type() const noexcept;
+   r::TypeContext& get_type_context() const noexcept;
 
    // llvm.cpp
    llvm::Function* get_llvm_function() const noexcept;
@@ -84,6 +105,12 @@ struct Resolver final
    llvm::Type* get_llvm_type(const r::Type& type, std::size_t dropped_subtypes = 0UZ);
    std::size_t get_pointer_bit_depth() const noexcept;
 
+   // layout.cpp
+   const r::ObjectLayout& get_object_layout(r::Object& object);
+   std::size_t get_byte_size(const r::Type& type);
+   std::size_t get_alignment(const r::Type& type);
+   std::size_t get_size_of(const r::Operation& operation, r::Builder* builder = nullptr);
+
    // procedures.cpp
    r::ProcedureGroup& get_procedure_group(const r::Expression& expression, r::Builder* builder = nullptr);
    r::Procedure& get_call_procedure(const r::Operation& call_operation, r::Builder* builder = nullptr);
@@ -113,6 +140,11 @@ struct Resolver final
    r::ObjectExtension& add_object_extension();
    r::ProcedureGroup& add_procedure_group();
    r::Property& add_property();
+   // catalogs a symbol that was only tabulated. does nothing once it is
+   // cataloged or while it is being cataloged.
+   void ensure_cataloged(r::Procedure& procedure);
+   void ensure_cataloged(r::Object& object);
+   void ensure_cataloged(r::Global& global);
    r::TypeAlias& add_type_alias();
 };
 
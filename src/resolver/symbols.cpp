@@ -6,8 +6,13 @@
 #include <module/module.hpp>
 #include <export_group.hpp>
 #include <binary.hpp>
+#include <procedure.hpp>
+#include <object.hpp>
+#include <global.hpp>
+#include <cataloger/cataloger.hpp>
 
 #include <cassert>
+#include <stdexcept>
 
 namespace r {
 
@@ -63,4 +68,38 @@ r::TypeAlias& Resolver::add_type_alias()
     return this->module->add_type_alias();
 }
 
+void Resolver::ensure_cataloged(r::Procedure& procedure)
+{
+    if (procedure.catalog_state != r::CatalogState::TABULATED)
+    {
+        return;
+    }
+    r::Cataloger cataloger{};
+    cataloger.catalog_on_demand(procedure);
+}
+
+void Resolver::ensure_cataloged(r::Object& object)
+{
+    if (object.catalog_state != r::CatalogState::TABULATED)
+    {
+        return;
+    }
+    r::Cataloger cataloger{};
+    cataloger.catalog_on_demand(object);
+}
+
+void Resolver::ensure_cataloged(r::Global& global)
+{
+    if (global.catalog_state == r::CatalogState::CATALOGING)
+    {
+        throw std::runtime_error("global value depends on itself.");
+    }
+    if (global.catalog_state != r::CatalogState::TABULATED)
+    {
+        return;
+    }
+    r::Cataloger cataloger{};
+    cataloger.catalog_on_demand(global);
+}
+
 }
\ No newline at end of file
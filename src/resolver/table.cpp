@@ -10,9 +10,15 @@
 #include <binary.hpp>
 #include <utility.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <ranges>
 #include <cstddef>
 
+#define DEBUG_TYPE "requite-resolver"
+
+ALWAYS_ENABLED_STATISTIC(NumVisibleSymbolLookups, "module scope lookups in the visible symbol index");
+
 namespace r {
 
 void Resolver::access_table(const r::Operation& operation, bool ignore_last)
@@ -210,6 +216,20 @@ r::Symbol* Resolver::try_get_symbol(std::string_view name)
     { // try searching the export group table.
         symbol = this->export_group->table.try_get_symbol(name);
     }
+    if (
+        symbol == nullptr &&
+        this->module != nullptr &&
+        this->module->has_visible_symbols
+    )
+    { // the module and binary tables are flattened into one index.
+        ++NumVisibleSymbolLookups;
+        auto symbol_iter = this->module->visible_symbols.find(name);
+        if (symbol_iter == this->module->visible_symbols.end())
+        {
+            return nullptr;
+        }
+        return &symbol_iter->second;
+    }
     if (
         symbol == nullptr &&
         this->module != nullptr
@@ -14,6 +14,10 @@
 #include <builder/builder.hpp>
 #include <procedure.hpp>
 #include <type_alias.hpp>
+#include <type_context.hpp>
+#include <object_layout.hpp>
+
+#include <llvm/ADT/Statistic.h>
 
 #include <optional>
 #include <stdexcept>
@@ -22,6 +26,11 @@
 #include <ranges>
 #include <cstddef>
 
+#define DEBUG_TYPE "requite-resolver"
+
+ALWAYS_ENABLED_STATISTIC(NumDeduceTypeCalls, "calls to deduce_type");
+ALWAYS_ENABLED_STATISTIC(NumDeduceTypeCacheHits, "deduced types found in the cache");
+
 namespace r {
 
 bool Resolver::get_is_type_assignable_to_type(const r::Type& from, const r::Type& to)
@@ -68,7 +77,7 @@ bool Resolver::get_is_type_assignable_to_type(const r::Type& from, const r::Type
             }
         }
     }
-    else if (to.root != to.root)
+    else if (from.root != to.root)
     {
         return false;
     }
@@ -115,7 +124,7 @@ std::size_t Resolver::get_bit_depth(const r::Type& type)
     {
         r::Type copy = type;
         copy.subtypes.pop_back();
-        return this->get_bit_depth(type) * type.get_array_size();
+        return this->get_bit_depth(copy) * type.get_array_size();
     }
     else if (std::holds_alternative<r::Codeunit>(type.root))
     {
@@ -145,16 +154,11 @@ std::size_t Resolver::get_bit_depth(const r::Type& type)
     else if (std::holds_alternative<r::Object*>(type.root))
     {
         r::Object& object = *std::get<r::Object*>(type.root);
-        // TODO
+        return this->get_object_layout(object).byte_size * 8UZ;
     }
     r::unreachable();
 }
 
-std::size_t Resolver::get_byte_size(const r::Type& type)
-{
-    return this->get_bit_depth(type) * 8UZ;
-}
-
 r::Type Resolver::resolve_type(const r::Expression& expression, bool can_fail)
 {
     r::Type type;
@@ -186,10 +190,12 @@ r::Type Resolver::resolve_type(const r::Expression& expression, bool can_fail)
                     next_subtype.set_volatile(qualifier_is_volatile);
                     assert(operation.branches.size() == 2UZ);
                     const r::Expression& size_expression = operation.branches.back();
-                    assert(std::holds_alternative<r::Literal>(size_expression));
-                    const r::Literal& size_literal = std::get<r::Literal>(size_expression);
-                    assert(size_literal.type == r::LiteralType::NUMBER);
-                    next_subtype.array_size = r::to_number(size_literal.text);
+                    llvm::APSInt llvm_ap_sint =
+                        this->get_integer_constant(
+                            size_expression,
+                            this->get_uptr_type()
+                        );
+                    next_subtype.array_size = llvm_ap_sint.getLimitedValue();
                     qualifier_is_mutable = false;
                     qualifier_is_volatile = false;
                     expression_ptr = &operation.branches.front();
@@ -406,18 +412,46 @@ r::Type Resolver::resolve_type(const r::Expression& expression, bool can_fail)
 
 r::Type Resolver::deduce_type(const r::Expression& expression, r::Builder* builder)
 {
-    if (builder != nullptr)
+    ++NumDeduceTypeCalls;
+    if (
+        builder == nullptr ||
+        !std::holds_alternative<r::Operation>(expression)
+    )
+    { // names and literals are cheaper to deduce than to look up.
+        return this->deduce_uncached_type(expression, builder);
+    }
+    const r::Operation& operation = std::get<r::Operation>(expression);
+    if (const r::Type* deduced_type = builder->try_get_deduced_type(operation))
+    {
+        ++NumDeduceTypeCacheHits;
+        return *deduced_type;
+    }
+    r::Type type = this->deduce_uncached_type(expression, builder);
+    builder->add_deduced_type(operation, type);
+    return type;
+}
+
+r::Type Resolver::deduce_uncached_type(const r::Expression& expression, r::Builder* builder)
+{
+    if (std::holds_alternative<std::string_view>(expression))
     {
-        if (std::holds_alternative<std::string_view>(expression))
+        std::string_view name = std::get<std::string_view>(expression);
+        if (builder != nullptr)
         {
-            std::string_view name = std::get<std::string_view>(expression);
             r::Local* local = builder->try_get_local(name);
-            if (local == nullptr)
+            if (local != nullptr)
             {
-                throw std::runtime_error("variable not found with name.");
+                return local->type;
             }
-            return local->type;
         }
+        r::Symbol* symbol = this->try_get_symbol(name);
+        if (symbol == nullptr || !std::holds_alternative<r::Global*>(*symbol))
+        {
+            throw std::runtime_error("variable not found with name.");
+        }
+        r::Global& global = *std::get<r::Global*>(*symbol);
+        this->ensure_cataloged(global);
+        return global.type;
     }
     if (std::holds_alternative<r::Operation>(expression))
     {
@@ -435,6 +469,7 @@ r::Type Resolver::deduce_type(const r::Expression& expression, r::Builder* build
             const r::Expression& last_expression = operation.branches.back();
             assert(std::holds_alternative<std::string_view>(last_expression));
             std::string_view property_name = std::get<std::string_view>(last_expression);
+            this->ensure_cataloged(*object);
             r::Property& property = object->get_property(property_name);
             return property.type;
         }
@@ -511,14 +546,36 @@ r::Type Resolver::deduce_type(const r::Expression& expression, r::Builder* build
             assert(operation.branches.empty());
             return r::NULL_TYPE;
         }
-        if (operation.opcode == r::Opcode::POINTER_DEPTH)
+        if (
+            operation.opcode == r::Opcode::POINTER_DEPTH ||
+            operation.opcode == r::Opcode::SIZE_OF
+        )
         {
             return this->get_uptr_type();
         }
-        if (r::get_is_math_opcode(operation.opcode))
+        if (
+            r::get_is_math_opcode(operation.opcode) ||
+            operation.opcode == r::Opcode::AND ||
+            operation.opcode == r::Opcode::PIPE ||
+            operation.opcode == r::Opcode::CAROT ||
+            operation.opcode == r::Opcode::TILDE
+        )
         {
             return this->deduce_group_type(operation.branches, builder);
         }
+        if (
+            operation.opcode == r::Opcode::LESS_LESS ||
+            operation.opcode == r::Opcode::GREATER_GREATER
+        )
+        {
+            assert(operation.branches.size() == 2UZ);
+            return this->deduce_type(operation.branches.front(), builder);
+        }
+        if (operation.opcode == r::Opcode::QUESTION)
+        {
+            assert(operation.branches.size() == 3UZ);
+            return this->deduce_group_type(std::span(operation.branches).subspan(1UZ), builder);
+        }
         if (r::get_opcode_returns_bool(operation.opcode))
         {
             return r::BOOL_TYPE;
@@ -619,6 +676,12 @@ r::Type Resolver::deduce_group_type(const r::Type& type_a, const r::Type& type_b
     throw std::runtime_error("no common type found.");
 }
 
+r::TypeContext& Resolver::get_type_context() const noexcept
+{
+    assert(this->binary != nullptr);
+    return this->binary->type_context;
+}
+
 r::Type Resolver::get_uptr_type() const noexcept
 {
     std::size_t pointer_depth = this->get_pointer_bit_depth();
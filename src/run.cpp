@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <compiler.hpp>
+#include <binary.hpp>
+#include <module/module.hpp>
+#include <procedure.hpp>
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/Error.h>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace r {
+
+namespace {
+
+void check_llvm_error(llvm::Error error)
+{
+    if (error)
+    {
+        throw std::runtime_error(llvm::toString(std::move(error)));
+    }
+}
+
+template<typename T>
+T check_llvm_expected(llvm::Expected<T> expected)
+{
+    if (!expected)
+    {
+        throw std::runtime_error(llvm::toString(expected.takeError()));
+    }
+    return std::move(*expected);
+}
+
+}
+
+int Compiler::run(r::Binary& binary)
+{
+    if (binary.entry_point == nullptr)
+    {
+        throw std::runtime_error("run mode requires an entry point.");
+    }
+    std::unique_ptr<llvm::orc::LLJIT> jit =
+        r::check_llvm_expected(
+            llvm::orc::LLJITBuilder().create()
+        );
+    llvm::orc::JITDylib& main_dylib = jit->getMainJITDylib();
+    // external functions such as printf and puts are resolved from the host
+    // process instead of being linked.
+    main_dylib.addGenerator(
+        r::check_llvm_expected(
+            llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+                jit->getDataLayout().getGlobalPrefix()
+            )
+        )
+    );
+    // the jit shares ownership of the context with the binary, which keeps it
+    // alive after the jit and its modules are destroyed.
+    binary.llvm_thread_safe_context = llvm::orc::ThreadSafeContext(std::move(binary.llvm_context));
+    for (r::Module& module : binary.modules)
+    {
+        assert(module.llvm_module != nullptr);
+        module.llvm_module->setDataLayout(jit->getDataLayout());
+        module.llvm_module->setTargetTriple(jit->getTargetTriple().str());
+        r::check_llvm_error(
+            jit->addIRModule(
+                main_dylib,
+                llvm::orc::ThreadSafeModule(
+                    std::move(module.llvm_module),
+                    binary.llvm_thread_safe_context
+                )
+            )
+        );
+    }
+    r::check_llvm_error(jit->initialize(main_dylib));
+    llvm::orc::ExecutorAddr entry_point_address =
+        r::check_llvm_expected(
+            jit->lookup(binary.entry_point->mangled_name)
+        );
+    int (*entry_point)() = entry_point_address.toPtr<int (*)()>();
+    const int exit_code = entry_point();
+    r::check_llvm_error(jit->deinitialize(main_dylib));
+    return exit_code;
+}
+
+}
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// a position in a source file. lines and columns start at 1.
+struct SourceLocation final
+{
+    unsigned line = 0U;
+    unsigned column = 0U;
+};
+
+}
@@ -13,9 +13,17 @@
 #include <resolver/resolver.hpp>
 #include <utility.hpp>
 
+#include <llvm/ADT/Statistic.h>
+
 #include <stdexcept>
 #include <utility>
 
+#define DEBUG_TYPE "requite-symbols"
+
+ALWAYS_ENABLED_STATISTIC(NumSymbolLookups, "symbol table lookups");
+ALWAYS_ENABLED_STATISTIC(NumSymbolLookupMisses, "symbol table lookups that found nothing");
+ALWAYS_ENABLED_STATISTIC(NumSymbolInserts, "symbols added to tables");
+
 namespace r {
 
 void throw_disambiguous_symbol_name()
@@ -25,137 +33,124 @@ void throw_disambiguous_symbol_name()
 
 void SymbolTable::add_to_table(r::Procedure& procedure, r::Resolver& resolver)
 {
-    r::ProcedureGroup* procedure_group_ptr = nullptr;
-    if (this->table.contains(procedure.name))
+    auto [symbol_iter, is_inserted] = this->table.try_emplace(procedure.name);
+    if (is_inserted)
     {
-        r::Symbol& symbol = this->table.at(procedure.name);
-        if (!std::holds_alternative<r::ProcedureGroup*>(symbol))
-        {
-            r::throw_disambiguous_symbol_name();
-        }
-        procedure_group_ptr = std::get<r::ProcedureGroup*>(symbol);
+        ++NumSymbolInserts;
+        symbol_iter->second = &resolver.add_procedure_group();
     }
-    else
+    else if (!std::holds_alternative<r::ProcedureGroup*>(symbol_iter->second))
     {
-        procedure_group_ptr = &resolver.add_procedure_group();
-        this->table[procedure.name] = procedure_group_ptr;
+        r::throw_disambiguous_symbol_name();
     }
+    r::ProcedureGroup* procedure_group_ptr = std::get<r::ProcedureGroup*>(symbol_iter->second);
     procedure_group_ptr->add_overload(procedure, resolver);
 }
 
 void SymbolTable::add_to_table(r::Global& global)
 {
-    if (this->table.contains(global.name))
-    {
-        r::throw_disambiguous_symbol_name();
-    }
-    this->table[global.name] = &global;
+    this->add_symbol(global.name, &global);
 }
 
 void SymbolTable::add_to_table(r::Object& object)
 {
-    if (this->table.contains(object.name))
-    {
-        r::throw_disambiguous_symbol_name();
-    }
-    this->table[object.name] = &object;    
+    this->add_symbol(object.name, &object);
 }
 
 void SymbolTable::add_to_table(r::ExportGroup& export_group)
 {
-    if (this->table.contains(export_group.name))
-    {
-        r::throw_disambiguous_symbol_name();
-    }
-    this->table[export_group.name] = &export_group; 
+    this->add_symbol(export_group.name, &export_group);
 }
 
 void SymbolTable::add_to_table(r::TypeAlias& type_alias)
 {
-    if (this->table.contains(type_alias.name))
-    {
-        r::throw_disambiguous_symbol_name();
-    }
-    this->table[type_alias.name] = &type_alias; 
+    this->add_symbol(type_alias.name, &type_alias);
 }
 
 r::ProcedureGroup* SymbolTable::try_get_procedure_group(std::string_view name)
 {
-    if (!this->table.contains(name))
-    {
-        return nullptr;
-    }
-    r::Symbol& symbol = this->table.at(name);
-    if (!std::holds_alternative<r::ProcedureGroup*>(symbol))
+    r::Symbol* symbol = this->try_get_symbol(name);
+    if (
+        symbol == nullptr ||
+        !std::holds_alternative<r::ProcedureGroup*>(*symbol)
+    )
     {
         return nullptr;
     }
-    return std::get<r::ProcedureGroup*>(symbol);
+    return std::get<r::ProcedureGroup*>(*symbol);
 }
 
 r::Global* SymbolTable::try_get_global(std::string_view name)
 {
-    if (!this->table.contains(name))
+    r::Symbol* symbol = this->try_get_symbol(name);
+    if (
+        symbol == nullptr ||
+        !std::holds_alternative<r::Global*>(*symbol)
+    )
     {
         return nullptr;
     }
-    r::Symbol& symbol = this->table.at(name);
-    if (!std::holds_alternative<r::Global*>(symbol))
-    {
-        return nullptr;
-    }
-    return std::get<r::Global*>(symbol);
+    return std::get<r::Global*>(*symbol);
 }
 
 r::Object* SymbolTable::try_get_object(std::string_view name)
 {
-    if (!this->table.contains(name))
+    r::Symbol* symbol = this->try_get_symbol(name);
+    if (
+        symbol == nullptr ||
+        !std::holds_alternative<r::Object*>(*symbol)
+    )
     {
         return nullptr;
     }
-    r::Symbol& symbol = this->table.at(name);
-    if (!std::holds_alternative<r::Object*>(symbol))
-    {
-        return nullptr;
-    }
-    return std::get<r::Object*>(symbol);
+    return std::get<r::Object*>(*symbol);
 }
 
 r::ExportGroup* SymbolTable::try_get_export_group(std::string_view name)
 {
-    if (!this->table.contains(name))
-    {
-        return nullptr;
-    }
-    r::Symbol& symbol = this->table.at(name);
-    if (!std::holds_alternative<r::ExportGroup*>(symbol))
+    r::Symbol* symbol = this->try_get_symbol(name);
+    if (
+        symbol == nullptr ||
+        !std::holds_alternative<r::ExportGroup*>(*symbol)
+    )
     {
         return nullptr;
     }
-    return std::get<r::ExportGroup*>(symbol);
+    return std::get<r::ExportGroup*>(*symbol);
 }
 
 r::TypeAlias* SymbolTable::try_get_type_alias(std::string_view name)
 {
-    if (!this->table.contains(name))
+    r::Symbol* symbol = this->try_get_symbol(name);
+    if (
+        symbol == nullptr ||
+        !std::holds_alternative<r::TypeAlias*>(*symbol)
+    )
     {
         return nullptr;
     }
-    r::Symbol& symbol = this->table.at(name);
-    if (!std::holds_alternative<r::TypeAlias*>(symbol))
-    {
-        return nullptr;
-    }
-    return std::get<r::TypeAlias*>(symbol);
+    return std::get<r::TypeAlias*>(*symbol);
 }
 
 r::Symbol* SymbolTable::try_get_symbol(std::string_view name)
 {
-    if (!this->table.contains(name))
+    ++NumSymbolLookups;
+    auto symbol_iter = this->table.find(name);
+    if (symbol_iter == this->table.end())
     {
+        ++NumSymbolLookupMisses;
         return nullptr;
     }
-    return &this->table.at(name);
+    return &symbol_iter->second;
+}
+
+void SymbolTable::add_symbol(std::string_view name, r::Symbol symbol)
+{ // one probe both checks for a duplicate and inserts.
+    if (!this->table.try_emplace(name, symbol).second)
+    {
+        r::throw_disambiguous_symbol_name();
+    }
+    ++NumSymbolInserts;
 }
 
 }
\ No newline at end of file
@@ -6,8 +6,10 @@
 
 #include <symbol.hpp>
 
-#include <map>
-#include <string>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string_view>
 
 namespace r {
 
@@ -17,9 +19,11 @@ struct Binary;
 struct Resolver;
 struct Procedure;
 
+// open addressing, so pointers returned by the lookups are invalidated when
+// something is added to the table.
 struct SymbolTable final
 {
-    std::map<std::string_view, r::Symbol> table{};
+    llvm::DenseMap<llvm::StringRef, r::Symbol> table{};
 
     void add_to_table(r::Procedure& procedure, r::Resolver& resolver);
     void add_to_table(r::Global& global); 
@@ -33,6 +37,9 @@ struct SymbolTable final
     r::ExportGroup* try_get_export_group(std::string_view name);
     r::TypeAlias* try_get_type_alias(std::string_view name);
     r::Symbol* try_get_symbol(std::string_view name);
+
+private:
+    void add_symbol(std::string_view name, r::Symbol symbol);
 };
 
 
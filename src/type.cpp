@@ -615,6 +615,49 @@ const r::Integer& Type::get_integer() const noexcept
     return std::get<r::Integer>(this->root);
 }
 
+r::TypeKind Type::get_kind() const noexcept
+{
+    if (!this->subtypes.empty())
+    {
+        const r::Subtype& front_subtype = this->subtypes.front();
+        if (front_subtype.qualifiers.test(r::QualifierFlag::POINTER))
+        {
+            return r::TypeKind::POINTER;
+        }
+        if (front_subtype.qualifiers.test(r::QualifierFlag::ARRAY))
+        {
+            return r::TypeKind::ARRAY;
+        }
+        return r::TypeKind::UNKNOWN;
+    }
+    if (std::holds_alternative<r::Codeunit>(this->root))
+    {
+        return r::TypeKind::CODEUNIT;
+    }
+    if (std::holds_alternative<r::Integer>(this->root))
+    {
+        return r::TypeKind::INTEGER;
+    }
+    if (std::holds_alternative<r::FloatingPoint>(this->root))
+    {
+        return r::TypeKind::FLOATING_POINT;
+    }
+    if (std::holds_alternative<r::FixedPoint>(this->root))
+    {
+        return r::TypeKind::FIXED_POINT;
+    }
+    if (std::holds_alternative<r::SpecialType>(this->root))
+    {
+        return r::TypeKind::SPECIAL_TYPE;
+    }
+    if (std::holds_alternative<r::Object*>(this->root))
+    {
+        return r::TypeKind::OBJECT;
+    }
+    // unresolved type aliases and empty types.
+    return r::TypeKind::UNKNOWN;
+}
+
 bool operator==(const r::Subtype& lhs, const r::Subtype& rhs) noexcept
 {
     return 
@@ -675,6 +718,12 @@ bool Type::get_is_llvm_value_type() const noexcept
     {
         return true;
     }
+    // pointers to objects are passed and returned in registers, not through
+    // an sret argument.
+    if (this->get_is_pointer())
+    {
+        return true;
+    }
     return false;
 }
 
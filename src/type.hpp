@@ -9,6 +9,7 @@
 #include <operation.hpp>
 #include <qualifiers.hpp>
 #include <subtype.hpp>
+#include <type_kind.hpp>
 
 #include <llvm/IR/Type.h>
 #include <llvm/ADT/SmallVector.h>
@@ -69,6 +70,7 @@ struct Type final
     bool get_is_literal() const noexcept;
     void clear_literals() noexcept;
     bool get_is_type_alias() const noexcept;
+    r::TypeKind get_kind() const noexcept;
     void resolve_type_alias() noexcept;
 
     r::Object& get_object() noexcept;
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include <type_context.hpp>
+
+#include <llvm/ADT/Statistic.h>
+
+#include <variant>
+
+#define DEBUG_TYPE "requite-types"
+
+ALWAYS_ENABLED_STATISTIC(NumInternedTypes, "distinct types interned");
+
+namespace r {
+
+namespace {
+
+void profile(llvm::FoldingSetNodeID& id, const r::QualifierFlagSet& qualifiers)
+{
+    for (std::size_t flag_i = 0UZ; flag_i < r::QualifierFlag::COUNT; flag_i++)
+    {
+        id.AddBoolean(qualifiers.test(flag_i));
+    }
+}
+
+void profile(llvm::FoldingSetNodeID& id, const r::Type& type)
+{
+    id.AddInteger(type.root.index());
+    if (std::holds_alternative<r::Codeunit>(type.root))
+    {
+        id.AddInteger(static_cast<unsigned>(std::get<r::Codeunit>(type.root).encoding));
+    }
+    else if (std::holds_alternative<r::Integer>(type.root))
+    {
+        const r::Integer& integer = std::get<r::Integer>(type.root);
+        id.AddInteger(static_cast<unsigned>(integer.type));
+        id.AddInteger(integer.bit_depth);
+    }
+    else if (std::holds_alternative<r::FloatingPoint>(type.root))
+    {
+        id.AddInteger(static_cast<unsigned>(std::get<r::FloatingPoint>(type.root).type));
+    }
+    else if (std::holds_alternative<r::FixedPoint>(type.root))
+    {
+        const r::FixedPoint& fixed_point = std::get<r::FixedPoint>(type.root);
+        id.AddInteger(fixed_point.integer_bits);
+        id.AddInteger(fixed_point.decimal_bits);
+    }
+    else if (std::holds_alternative<r::SpecialType>(type.root))
+    {
+        id.AddInteger(static_cast<unsigned>(std::get<r::SpecialType>(type.root)));
+    }
+    else if (std::holds_alternative<r::Object*>(type.root))
+    {
+        id.AddPointer(std::get<r::Object*>(type.root));
+    }
+    else if (std::holds_alternative<r::TypeAlias*>(type.root))
+    {
+        id.AddPointer(std::get<r::TypeAlias*>(type.root));
+    }
+    r::profile(id, type.qualifiers);
+    id.AddInteger(type.subtypes.size());
+    for (const r::Subtype& subtype : type.subtypes)
+    {
+        r::profile(id, subtype.qualifiers);
+        id.AddInteger(subtype.array_size);
+    }
+}
+
+}
+
+InternedType::InternedType(const r::Type& type)
+    : type(type)
+{}
+
+void InternedType::Profile(llvm::FoldingSetNodeID& id) const
+{
+    r::profile(id, this->type);
+}
+
+const r::InternedType& TypeContext::intern(const r::Type& type)
+{
+    llvm::FoldingSetNodeID id;
+    r::profile(id, type);
+    void* insert_position = nullptr;
+    if (r::InternedType* interned_type = this->types.FindNodeOrInsertPos(id, insert_position))
+    {
+        return *interned_type;
+    }
+    ++NumInternedTypes;
+    r::InternedType* interned_type = new (this->allocator.Allocate()) r::InternedType(type);
+    this->types.InsertNode(interned_type, insert_position);
+    return *interned_type;
+}
+
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <type.hpp>
+
+#include <llvm/ADT/FoldingSet.h>
+#include <llvm/Support/Allocator.h>
+
+namespace r {
+
+// A type stored once by a TypeContext. two interned types are equal only if
+// they are the same object, so they are compared by address.
+struct InternedType final : llvm::FoldingSetNode
+{
+    r::Type type{};
+
+    InternedType(const r::Type& type);
+
+    void Profile(llvm::FoldingSetNodeID& id) const;
+};
+
+// Stores each distinct type once and hands out handles that stay valid for
+// the life of the context.
+struct TypeContext final
+{
+    const r::InternedType& intern(const r::Type& type);
+
+private:
+    llvm::SpecificBumpPtrAllocator<r::InternedType> allocator{};
+    llvm::FoldingSet<r::InternedType> types{};
+};
+
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2024 Daniel Aimé Valcour <fosssweeper@gmail.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace r {
+
+// the outermost shape of a type. types of different kinds are never
+// assignable to each other, except for literals.
+enum class TypeKind
+{
+    UNKNOWN,
+    POINTER,
+    ARRAY,
+    CODEUNIT,
+    INTEGER,
+    FLOATING_POINT,
+    FIXED_POINT,
+    SPECIAL_TYPE,
+    OBJECT
+};
+
+}
@@ -4,8 +4,12 @@
 
 # to compile the code:
 # build and run the requite C++ compiler with your requite source files in the build directory.
+# alternatively, set BuildCommand::mode to r::BuildMode::RUN in src/main.cpp to
+# run the entry point in memory and skip the object files and linker below.
 
 # to link the application (requires clang) (can use GCC instead if you want)
+# or set BuildCommand::link_output to r::LinkOutput::EXECUTABLE in src/main.cpp
+# to have the compiler link it to BuildCommand::output_path itself.
 clang <insert paths to built obj files here> -o example -lm
 
 # to give permissions to execute the compiled binary on linux:
@@ -15,4 +19,24 @@ chmod +x example
 ./example
 
 # to print the return code:
-echo $?
\ No newline at end of file
+echo $?
+
+# profile guided optimization:
+# 1. build with BuildCommand::profile_mode set to r::ProfileMode::INSTRUMENT and
+#    link with the profile runtime (done automatically by BuildCommand::link_output):
+#    clang <insert paths to built obj files here> -o example -lm -fprofile-generate
+# 2. run ./example on representative workloads, then merge the raw profiles:
+#    llvm-profdata merge -o example.profdata *.profraw
+# 3. rebuild with BuildCommand::profile_mode set to r::ProfileMode::USE,
+#    BuildCommand::profile_path set to example.profdata and an optimization
+#    level above r::OptimizationLevel::O0.
+
+# profiling with source lines:
+# build with BuildCommand::debug_info set to true, then:
+#    perf record ./example && perf report
+#    llvm-symbolizer --obj=example <address>
+
+# object layouts:
+# set BuildCommand::layout_report_path to write the size and padding of each
+# object as json. set BuildCommand::reorder_properties to lay out the
+# properties of every object that is not packed by alignment.